@@ -20,11 +20,30 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
 #pragma once
 
+#include <functional>
+#include <cstdint>
+#include <chrono>
 #include <string>
+#include <vector>
 
 namespace ap {
 struct ArgParserT;
 
+struct ParseStatsT {
+  std::size_t tokensSeen{};
+  std::size_t grammarTokens{};
+  std::size_t cellsEvaluated{};
+  std::size_t variantsTested{};
+  std::size_t backPointers{};
+  std::size_t peakChartBytes{};
+
+  std::uint64_t initParseChartNs{};
+  std::uint64_t parseCYKNs{};
+  std::uint64_t tracePostorderPathNs{};
+  std::uint64_t applySemanticActionsNs{};
+  std::uint64_t updateArgumentsNs{};
+};
+
 namespace Result {
 enum Type : int {
   Success,
@@ -52,7 +71,17 @@ enum Type : int {
 
   ErrorStartSymbolNotDerivedFromInput,
   ErrorInputTokenNotValid,
-  ErrorOptionRequiresValue
+  ErrorOptionRequiresValue,
+  ErrorQuoteNotTerminated,
+  ErrorEscapeNotTerminated,
+  ErrorArgLongFormAmbiguous,
+  ErrorSubcommandNotUnique,
+  ErrorFileAccessFailure,
+  ErrorSpecFormatNotValid,
+  ErrorValueNotValid,
+  ErrorValueOutOfRange,
+  ErrorBufferSizeNotValid,
+  ErrorParseResultNotValid
 };
 
 int toString(int const result, std::string *const output);
@@ -68,11 +97,97 @@ int addFlag(ArgParserT *const handle, std::string const &argLongForm,
 int addOption(ArgParserT *const handle, std::string const &argLongForm,
               char const argShortForm = 0);
 
+// Builds the lookup tables of the registered arguments. Calling it is
+// optional, as the tables are otherwise built when they are first needed.
+int freezeSpec(ArgParserT *const handle);
+
+// Writes the registered flags and options, along with their lookup tables,
+// to a binary file. Loading it maps the file into memory in place of
+// registering the arguments one by one. It may only be loaded into a
+// handle without any arguments registered. Subcommands are not saved.
+int saveSpec(ArgParserT *const handle, std::string const &path);
+
+int loadSpec(ArgParserT *const handle, std::string const &path);
+
+// Lets long forms be abbreviated to any of their unambiguous prefixes.
+int allowLongFormAbbreviations(ArgParserT *const handle, bool const allow);
+
+// The spec of a subcommand registers its arguments on the given handle.
+// It is only invoked when the name of the subcommand is met while parsing,
+// and the remaining tokens are then parsed by that handle. A spec which
+// fails is invoked again on a new handle the next time.
+using SubcommandSpecT = std::function<int(ArgParserT *const)>;
+
+int addSubcommand(ArgParserT *const handle, std::string const &name,
+                  SubcommandSpecT const &spec);
+
 int parse(ArgParserT *const handle, char const *const *const input,
           std::size_t const begin, std::size_t const end);
 
+// Splits the input into tokens the way a POSIX shell does, honouring
+// quotes and backslash escapes, and parses them. No expansions are done.
+int parseCommandString(ArgParserT *const handle, std::string const &input);
+
+// The position, counted from the beginning of the input, of the token the
+// last parse failed at. It is 0 after a parse which succeeded.
 int getErrorPosition(ArgParserT *const handle, std::size_t *const output);
 
+// Registers the values offered when completing the value of an option.
+int setOptionValueChoices(ArgParserT *const handle,
+                          std::string const &argLongForm,
+                          std::vector<std::string> const &choices);
+
+// Outputs the candidates for the token at the cursor, which lies within
+// [begin, end], or equals end when a new token is started. The tokens
+// before the cursor select a subcommand or an option awaiting a value,
+// but are not parsed. Repeated queries differing only in the token at
+// the cursor reuse the work done for the previous one.
+int complete(ArgParserT *const handle, char const *const *const input,
+             std::size_t const begin, std::size_t const end,
+             std::size_t const cursor,
+             std::vector<std::string> *const candidates);
+
+// Serializes the parsed flags, options and free values, along with those
+// of the subcommand met, into a flat buffer holding no pointers, e.g. one
+// in shared memory. The required size is stored in size; when buffer is
+// null, nothing else is done. The names and values may take up to 4 GiB.
+int saveParseResult(ArgParserT const *const handle, void *const buffer,
+                    std::size_t const capacity, std::size_t *const size);
+
+// Makes the accessors read the results from a buffer written by
+// saveParseResult, aligned to 8 bytes, in place of the parsed ones.
+// The buffer is not copied, and must outlive the attachment. Attaching
+// a null buffer, or parsing again, detaches it. getSubcommand outputs
+// a handle holding the results of the subcommand, owned by this one.
+int attachParseResult(ArgParserT *const handle, void const *const data,
+                      std::size_t const size);
+
+// Outputs the registered long form closest to the last unknown one,
+// or an empty string if none of them is close enough.
+int getLongFormSuggestion(ArgParserT *const handle, std::string *const output);
+
+// When enabled, every call to parse resets and fills in the statistics
+// returned by getParseStats. The parseCYK time excludes initParseChart.
+int collectParseStats(ArgParserT *const handle, bool const enable);
+
+int getParseStats(ArgParserT const *const handle, ParseStatsT *const output);
+
+// Tokens classified by the grammar are memoized in an LRU cache holding at
+// most maxBytes of memory. A size of 0 (the default) disables the cache.
+int setTokenCacheSize(ArgParserT *const handle, std::size_t const maxBytes);
+
+int getTokenCacheHitCount(ArgParserT const *const handle,
+                          std::size_t *const count);
+
+int getTokenCacheMissCount(ArgParserT const *const handle,
+                           std::size_t *const count);
+
+// Outputs the subcommand met by the last parse, along with the handle which
+// holds its arguments. Their positions are relative to the token following
+// the subcommand name. If no subcommand was met, the handle is null.
+int getSubcommand(ArgParserT const *const handle, std::string *const name,
+                  ArgParserT **const subcommand);
+
 int getFlagCount(ArgParserT const *const handle, std::string const &argLongForm,
                  std::size_t *const count);
 
@@ -94,6 +209,52 @@ int getOptionInstanceValue(ArgParserT const *const handle,
                            std::size_t const instanceIndex,
                            std::string *const value);
 
+// Typed views of an option value. The first successful conversion of an
+// instance is cached with it, so repeated calls of the same type do not
+// parse the text again, and the calls may run from several threads at
+// once. Enum positions are not cached. When a conversion fails, the offset within the value where it stopped
+// is stored in errorOffset, unless it is null.
+int getOptionInstanceInt(ArgParserT const *const handle,
+                         std::string const &argLongForm,
+                         std::size_t const instanceIndex,
+                         std::int64_t *const value,
+                         std::size_t *const errorOffset = nullptr);
+
+int getOptionInstanceFloat(ArgParserT const *const handle,
+                           std::string const &argLongForm,
+                           std::size_t const instanceIndex, double *const value,
+                           std::size_t *const errorOffset = nullptr);
+
+// Accepts true/false, yes/no, on/off and 1/0.
+int getOptionInstanceBool(ArgParserT const *const handle,
+                          std::string const &argLongForm,
+                          std::size_t const instanceIndex, bool *const value,
+                          std::size_t *const errorOffset = nullptr);
+
+// Accepts a sequence of <integer><unit> pairs, e.g. "1h30m",
+// where the unit is one of ns, us, ms, s, m, h, d.
+int getOptionInstanceDuration(ArgParserT const *const handle,
+                              std::string const &argLongForm,
+                              std::size_t const instanceIndex,
+                              std::chrono::nanoseconds *const value,
+                              std::size_t *const errorOffset = nullptr);
+
+// Accepts an integer with an optional suffix: B, K, M, G, T and
+// KiB, MiB, GiB, TiB are binary, kB, MB, GB, TB are decimal.
+int getOptionInstanceSize(ArgParserT const *const handle,
+                          std::string const &argLongForm,
+                          std::size_t const instanceIndex,
+                          std::uint64_t *const bytes,
+                          std::size_t *const errorOffset = nullptr);
+
+// Stores the index of the value within choices.
+int getOptionInstanceEnum(ArgParserT const *const handle,
+                          std::string const &argLongForm,
+                          std::size_t const instanceIndex,
+                          std::vector<std::string> const &choices,
+                          std::size_t *const choice,
+                          std::size_t *const errorOffset = nullptr);
+
 int getFreeValueCount(ArgParserT const *const handle, std::size_t *const count);
 
 int getFreeValueInstancePosition(ArgParserT const *const handle,
@@ -0,0 +1,63 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#pragma once
+
+/* A getopt_long compatible front end, for tools written against it.
+ * The option tables are the 'struct option' ones of <getopt.h>, and
+ * the state lives in the ap_ prefixed counterparts of optind, optarg,
+ * opterr and optopt, with the same meaning. Defining
+ * BADLINE_GETOPT_REPLACE before including this header maps the original
+ * names onto them.
+ *
+ * As with GNU getopt_long, the arguments are permuted so that the non
+ * options end up last, unless the option string starts with '+' or
+ * POSIXLY_CORRECT is set, and a leading '-' returns the non options
+ * in order as arguments of the option 1. A ':' following that makes
+ * a missing argument return ':' and disables the error messages.
+ * Long options may be abbreviated to an unambiguous prefix. The 'W;'
+ * extension is not supported.
+ */
+
+#include <getopt.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern char *ap_optarg;
+extern int ap_optind;
+extern int ap_opterr;
+extern int ap_optopt;
+
+int ap_getopt_long(int argc, char *const argv[], char const *optstring,
+                   struct option const *longopts, int *longindex);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef BADLINE_GETOPT_REPLACE
+#define optarg ap_optarg
+#define optind ap_optind
+#define opterr ap_opterr
+#define optopt ap_optopt
+#define getopt_long ap_getopt_long
+#endif
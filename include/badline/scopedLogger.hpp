@@ -20,8 +20,27 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <source_location>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// The levels the SL_INF, SL_WRN and SL_ERR macros are compiled in for.
+// Defining SL_MIN_LEVEL as SL_LEVEL_WARNING, for instance, removes every
+// SL_INF call from the build, along with its arguments.
+#define SL_LEVEL_INFO 1
+#define SL_LEVEL_WARNING 2
+#define SL_LEVEL_ERROR 4
+#define SL_LEVEL_OFF 8
+
+#ifndef SL_MIN_LEVEL
+#define SL_MIN_LEVEL SL_LEVEL_INFO
+#endif
 
 namespace sl {
 namespace Result {
@@ -29,11 +48,48 @@ constexpr int Success = 0;
 constexpr int ErrorMemoryAllocationFailure = 1;
 constexpr int ErrorNullptrParameter = 2;
 constexpr int ErrorLogBufferSizeNotValid = 3;
+constexpr int ErrorLogQueueFull = 4;
+constexpr int ErrorLogQueueSizeNotValid = 5;
+constexpr int ErrorFileAccessFailure = 6;
+constexpr int ErrorFlushPolicyNotValid = 7;
+constexpr int ErrorRingFileNotValid = 8;
+constexpr int ErrorBinaryLogNotValid = 9;
+constexpr int ErrorProfileBufferSizeNotValid = 10;
+constexpr int ErrorSampleRateNotValid = 11;
+constexpr int ErrorRateLimitNotValid = 12;
 }; // namespace Result
 
+namespace LogLevel {
+constexpr int Info = SL_LEVEL_INFO;
+constexpr int Warning = SL_LEVEL_WARNING;
+constexpr int Error = SL_LEVEL_ERROR;
+} // namespace LogLevel
+
+namespace FlushPolicy {
+constexpr int Record = 0;
+constexpr int Bytes = 1;
+constexpr int Interval = 2;
+constexpr int Error = 3;
+} // namespace FlushPolicy
+
+struct LogQueueStats {
+  std::size_t capacity{};
+  std::size_t occupancy{};
+  std::size_t peakOccupancy{};
+  std::size_t enqueued{};
+  std::size_t dropped{};
+  std::size_t written{};
+};
+
 struct LoggerT;
+struct ThreadState;
 using UniqueLogger = std::unique_ptr<LoggerT, void (*)(LoggerT *const)>;
 
+// A logger may be used by many threads at once. Every thread keeps its
+// own scope stack and one-time properties, and the outputs are shared.
+// The formats, the files and the asynchronous mode are set up before
+// other threads start logging, while the other properties may change
+// at any time.
 UniqueLogger createLogger(std::string const &);
 int createLogger(LoggerT **const handle, std::string const &);
 void destroyLogger(LoggerT *const handle);
@@ -41,11 +97,25 @@ void destroyLogger(LoggerT *const handle);
 int outputToConsole(LoggerT *const, bool const);
 int outputToFile(LoggerT *const, bool const);
 int outputToBuffer(LoggerT *const, bool const);
+int outputToRingFile(LoggerT *const, bool const);
+int outputToBinaryFile(LoggerT *const, bool const);
 
 int logLevelInf(LoggerT *const, bool const);
 int logLevelWrn(LoggerT *const, bool const);
 int logLevelErr(LoggerT *const, bool const);
 
+// Tells whether the entries of the given level are written, including the
+// one-time level, so that the logging macros only evaluate their
+// arguments when they are.
+bool isLogLevelEnabled(LoggerT *const, int const level);
+
+// The formats of the date and time prefix, as taken by strftime, with
+// %N for nanoseconds, and %<digits>N for fewer sub-second digits.
+// The prefix is formatted once per second and thread, and the sub-second
+// fields are filled in for every entry.
+int setDateFormat(LoggerT *const, std::string const &format);
+int setTimeFormat(LoggerT *const, std::string const &format);
+
 int appendNewLine(LoggerT *const, bool const);
 int flushStream(LoggerT *const, bool const);
 int prefixTime(LoggerT *const, bool const);
@@ -55,6 +125,7 @@ int prefixFunc(LoggerT *const, bool const);
 int oneTimeOutputToConsole(LoggerT *const, bool const);
 int oneTimeOutputToFile(LoggerT *const, bool const);
 int oneTimeOutputToBuffer(LoggerT *const, bool const);
+int oneTimeOutputToRingFile(LoggerT *const, bool const);
 
 int oneTimeLogLevelInf(LoggerT *const, bool const);
 int oneTimeLogLevelWrn(LoggerT *const, bool const);
@@ -66,16 +137,313 @@ int oneTimePrefixTime(LoggerT *const, bool const);
 int oneTimePrefixLevel(LoggerT *const, bool const);
 int oneTimePrefixFunc(LoggerT *const, bool const);
 
-int inf(LoggerT *const, std::string const &msg);
-int wrn(LoggerT *const, std::string const &msg);
-int err(LoggerT *const, std::string const &msg);
+int inf(LoggerT *const, std::string const &msg,
+        std::source_location const = std::source_location::current());
+int wrn(LoggerT *const, std::string const &msg,
+        std::source_location const = std::source_location::current());
+int err(LoggerT *const, std::string const &msg,
+        std::source_location const = std::source_location::current());
 
 int resizeLogBuffer(LoggerT *const, std::size_t const size);
 int printTrace(LoggerT *const);
 
+// In the asynchronous mode, the console output is pushed into a bounded
+// queue, and formatted and written by a writer thread. A message logged
+// while the queue is full is dropped, and ErrorLogQueueFull is returned.
+int writeAsync(LoggerT *const, bool const);
+
+// Opens the file the File output mode appends to. The entries are
+// collected in a buffer of the given size, and written out according
+// to the flush policy: after every record, once the threshold amount
+// of bytes is buffered, once threshold milliseconds have passed since
+// the last write, or after every error. The interval is checked when
+// logging. With syncLogFile enabled, every write is followed by fsync.
+int setLogFile(LoggerT *const, std::string const &path);
+int resizeLogFileBuffer(LoggerT *const, std::size_t const size);
+int setLogFileFlushPolicy(LoggerT *const, int const policy,
+                          std::size_t const threshold);
+int syncLogFile(LoggerT *const, bool const);
+int flushLogFile(LoggerT *const);
+
+// Maps a preallocated file of the given size as a circular buffer of
+// entries, which the RingFile output mode copies into without a system
+// call, overwriting the oldest ones once it is full. An existing ring
+// file of the same size is continued. The kernel writes the mapping
+// back even if the process crashes, and readRingLogFile recovers the
+// entries from it in order, along with the number of times the buffer
+// wrapped around.
+int setRingLogFile(LoggerT *const, std::string const &path,
+                   std::size_t const size);
+int readRingLogFile(std::string const &path,
+                    std::vector<std::string> *const entries,
+                    std::size_t *const wraps);
+
+// Opens the file the BinaryFile output mode writes to, replacing its
+// contents. The entries logged through the SL_INF, SL_WRN and SL_ERR
+// macros are written there as the id of their call site and scope,
+// a timestamp, and their arguments, leaving the formatting to
+// decodeBinaryLog, which returns the entries as they would have been
+// written to a text file. The binary entries follow the level and the
+// behavior of the logger, including the one-time properties.
+int setBinaryLogFile(LoggerT *const, std::string const &path);
+int flushBinaryLog(LoggerT *const);
+int decodeBinaryLog(std::string const &path,
+                    std::vector<std::string> *const entries);
+
+int resizeLogQueue(LoggerT *const, std::size_t const size);
+int flushLogQueue(LoggerT *const);
+int getLogQueueStats(LoggerT *const, LogQueueStats *const);
+
+struct SuppressionStats {
+  std::size_t rateLimited{};
+  std::size_t folded{};
+};
+
+/* Every call site, told apart by the location of the inf, wrn and err
+ * call or by the logging macro, may be limited to a number of entries per
+ * second, with bursts of up to the given number of entries; a rate of 0
+ * lifts the limit. With foldDuplicates, an entry equal to the last one
+ * its call site wrote is counted instead. Both are checked without a lock,
+ * before the entry is formatted, and once the call site writes again, it
+ * first writes how many of its entries were folded or dropped to the text
+ * outputs. The limits of a call site are taken from the logger it logs to.
+ */
+int setRateLimit(LoggerT *const, std::size_t const perSecond,
+                 std::size_t const burst);
+int foldDuplicates(LoggerT *const, bool const);
+int getSuppressionStats(LoggerT *const, SuppressionStats *const);
+
+// The calls of the scopes under one path of the call tree, such as
+// "logger;main;update", with the time spent in them, and that time less
+// the time spent in the scopes they entered.
+struct ScopeProfileEntry {
+  std::string path{};
+  std::size_t calls{};
+  std::uint64_t inclusiveNs{};
+  std::uint64_t exclusiveNs{};
+};
+
+struct ScopeProfile {
+  std::vector<ScopeProfileEntry> entries{};
+  std::size_t threads{};
+  std::size_t droppedScopes{};
+};
+
+/* In the profiling mode, every FunctionScope is timestamped on entry and
+ * exit into a buffer of its thread, holding the given number of events,
+ * past which the scopes are left out of the profile. Resizing the buffers
+ * clears the profile. The profile may be read while the threads run, and
+ * counts the scopes still open up to the time it is read. It is exported
+ * as Chrome Trace Event JSON, with a complete event for every scope, and
+ * as collapsed stacks weighted by the exclusive nanoseconds, as taken by
+ * flame graph tools.
+ */
+int profileScopes(LoggerT *const, bool const);
+int resizeProfileBuffer(LoggerT *const, std::size_t const events);
+int getScopeProfile(LoggerT *const, ScopeProfile *const);
+int writeChromeTrace(LoggerT *const, std::string const &path);
+int writeCollapsedStacks(LoggerT *const, std::string const &path);
+
+// The number of samples which found a thread under one path of the call
+// tree, in its innermost scope.
+struct SampleProfileEntry {
+  std::string path{};
+  std::size_t samples{};
+};
+
+struct SampleProfile {
+  std::vector<SampleProfileEntry> entries{};
+  std::size_t samples{};
+  std::size_t idleSamples{};
+  std::size_t missedSamples{};
+};
+
+/* A sampling thread copies the scope stacks of the threads using the
+ * logger at the given rate, which is 1000 samples a second by default,
+ * and counts the stacks it finds. The threads don't take a lock for it:
+ * a stack changed while it is copied is copied again, and the sample is
+ * missed if it keeps changing. The threads outside of any scope are
+ * counted as idle. The profile is kept once the sampling stops, until it
+ * starts again. It is printed as a call tree with the samples at or under
+ * every scope, or written as collapsed stacks weighted by the samples.
+ */
+int sampleScopes(LoggerT *const, bool const);
+int setSampleRate(LoggerT *const, std::size_t const hertz);
+int getSampleProfile(LoggerT *const, SampleProfile *const);
+int printSampleProfile(LoggerT *const);
+int writeSampledStacks(LoggerT *const, std::string const &path);
+
+/* A call site of the logging macros, registered the first time it logs.
+ * The arguments of an entry are packed next to the id of its call site,
+ * and substituted for the {} placeholders of the format when the entry is
+ * formatted; {{ and }} stand for literal braces. Integers, floating point
+ * numbers, booleans, characters and strings are supported, and the packed
+ * arguments of an entry are cut short at maxPackedArgsSize bytes.
+ */
+namespace detail {
+// The token bucket of a call site, kept as the time its next entry is due,
+// and the last entry it wrote, with the entries suppressed since.
+struct SiteLimiter {
+  std::atomic<std::int64_t> nextEntryNs{};
+  std::atomic<std::uint64_t> lastEntryHash{};
+  std::atomic<std::uint32_t> folded{};
+  std::atomic<std::uint32_t> rateLimited{};
+};
+} // namespace detail
+
+struct CallSite {
+  char const *format{};
+  int level{};
+  char const *function{};
+  char const *file{};
+  std::uint32_t line{};
+  std::atomic<std::uint32_t> id{};
+  detail::SiteLimiter limiter{};
+};
+
+namespace detail {
+constexpr std::size_t maxPackedArgsSize = 512;
+
+namespace ArgType {
+constexpr char Int = 'i';
+constexpr char Unsigned = 'u';
+constexpr char Double = 'd';
+constexpr char Bool = 'b';
+constexpr char Char = 'c';
+constexpr char String = 's';
+} // namespace ArgType
+
+struct PackedArgs {
+  char data[maxPackedArgsSize];
+  std::size_t size{};
+
+  void put(char const type, void const *const value, std::size_t const n) {
+    if (size + 1 + n > maxPackedArgsSize)
+      return;
+    data[size] = type;
+    std::memcpy(data + size + 1, value, n);
+    size += 1 + n;
+  }
+
+  void putString(std::string_view v) {
+    std::size_t const header = 1 + sizeof(std::uint32_t);
+    if (size + header > maxPackedArgsSize)
+      return;
+    v = v.substr(0, maxPackedArgsSize - size - header);
+    auto const length = std::uint32_t(v.size());
+    data[size] = ArgType::String;
+    std::memcpy(data + size + 1, &length, sizeof(length));
+    std::memcpy(data + size + header, v.data(), v.size());
+    size += header + v.size();
+  }
+};
+
+template <typename T> void pack(PackedArgs *const p, T const &v) {
+  if constexpr (std::is_same_v<T, bool>) {
+    p->put(ArgType::Bool, &v, 1);
+  } else if constexpr (std::is_same_v<T, char>) {
+    p->put(ArgType::Char, &v, 1);
+  } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+    auto const value = std::int64_t(v);
+    p->put(ArgType::Int, &value, sizeof(value));
+  } else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+    auto const value = std::uint64_t(v);
+    p->put(ArgType::Unsigned, &value, sizeof(value));
+  } else if constexpr (std::is_floating_point_v<T>) {
+    auto const value = double(v);
+    p->put(ArgType::Double, &value, sizeof(value));
+  } else {
+    static_assert(std::is_convertible_v<T const &, std::string_view>,
+                  "The argument can't be logged");
+    p->putString(v);
+  }
+}
+
+int logPacked(LoggerT *const, CallSite &site, PackedArgs const &args);
+
+// The number of {} placeholders in the format, or -1 if it has a brace
+// which is neither a placeholder nor escaped.
+constexpr int countPlaceholders(std::string_view const format) {
+  int count = 0;
+  for (std::size_t i = 0; i < format.size(); ++i) {
+    if (format[i] == '{') {
+      if (i + 1 == format.size())
+        return -1;
+      if (format[i + 1] == '}')
+        ++count;
+      else if (format[i + 1] != '{')
+        return -1;
+      ++i;
+    } else if (format[i] == '}') {
+      if (i + 1 == format.size() || format[i + 1] != '}')
+        return -1;
+      ++i;
+    }
+  }
+  return count;
+}
+} // namespace detail
+
+// A format checked at compile time against the arguments it is given,
+// as std::format does: a format with a stray brace, or with a different
+// number of placeholders than arguments, doesn't compile.
+template <typename... Args> struct FormatString {
+  template <typename S>
+    requires std::is_convertible_v<S const &, std::string_view>
+  consteval FormatString(S const &s) : str{s} {
+    if (detail::countPlaceholders(str) != int(sizeof...(Args)))
+      throw "The format doesn't match its arguments";
+  }
+
+  std::string_view str;
+};
+
+template <typename... Args>
+using CheckedFormat = FormatString<std::type_identity_t<Args>...>;
+
+template <typename... Args>
+int logAt(LoggerT *const l, CallSite &site, CheckedFormat<Args...> const,
+          Args const &...args) {
+  detail::PackedArgs packed;
+  (detail::pack(&packed, args), ...);
+  return detail::logPacked(l, site, packed);
+}
+
+// A scope name whose address is a constant expression, as that of a string
+// literal or of __func__, so that it outlives every logger. Any other
+// constant array of characters doesn't compile as one.
+class ScopeLiteral {
+public:
+  template <std::size_t N>
+  consteval ScopeLiteral(char const (&name)[N]) : name_{name} {}
+
+  char const *get() const { return name_; }
+
+private:
+  char const *name_;
+};
+
+/* Pushes its name onto the scope stack of the calling thread, whose top
+ * names the entries logged. A ScopeLiteral is kept by its address, and
+ * entering the scope takes no allocation or lock. Any other name, such
+ * as a string or an array of characters that may change, is interned the
+ * first time it is seen, and kept for the life of the process, so such
+ * names are best drawn from a bounded set. A thread entering a scope of
+ * a name it used recently takes no lock either.
+ */
 class FunctionScope {
 public:
-  FunctionScope(LoggerT *const logger, std::string const &funcName);
+  FunctionScope(LoggerT *const logger, ScopeLiteral const funcName)
+      : FunctionScope{logger, funcName.get(), Literal{}} {}
+  template <std::size_t N>
+  FunctionScope(LoggerT *const logger, char (&funcName)[N])
+      : FunctionScope{logger, static_cast<char const *>(funcName),
+                      Interned{}} {}
+  template <typename S>
+    requires(std::is_convertible_v<S const &, std::string_view> &&
+             !std::is_array_v<S>)
+  FunctionScope(LoggerT *const logger, S const &funcName)
+      : FunctionScope{logger, std::string_view{funcName}, Interned{}} {}
   FunctionScope(FunctionScope const &) = delete;
   FunctionScope &operator=(FunctionScope const &) = delete;
   FunctionScope(FunctionScope &&);
@@ -83,6 +451,39 @@ public:
   ~FunctionScope();
 
 private:
-  LoggerT *logger_;
+  struct Literal {};
+  struct Interned {};
+  FunctionScope(LoggerT *const logger, char const *const funcName, Literal);
+  FunctionScope(LoggerT *const logger, std::string_view const funcName,
+                Interned);
+
+  ThreadState *state_;
+  bool profiled_{};
 };
 } // namespace sl
+
+/* The arguments are only evaluated when the level is enabled, and the
+ * calls below SL_MIN_LEVEL are discarded at compile time. */
+#define SL_LOG_AT(logger, level, format, ...)                                  \
+  do {                                                                         \
+    if constexpr ((level) >= SL_MIN_LEVEL) {                                   \
+      ::sl::LoggerT *const slLogger = (logger);                                \
+      if (::sl::isLogLevelEnabled(slLogger, level)) {                          \
+        static ::sl::CallSite slCallSite{format, level, __func__, __FILE__,    \
+                                         __LINE__};                            \
+        ::sl::logAt(slLogger, slCallSite,                                      \
+                    format __VA_OPT__(, ) __VA_ARGS__);                        \
+      }                                                                        \
+    }                                                                          \
+  } while (false)
+
+// A scope named after the enclosing function.
+#define SL_FUNCTION_SCOPE(logger)                                              \
+  ::sl::FunctionScope const slFunctionScope{logger, __func__}
+
+#define SL_INF(logger, format, ...)                                            \
+  SL_LOG_AT(logger, ::sl::LogLevel::Info, format __VA_OPT__(, ) __VA_ARGS__)
+#define SL_WRN(logger, format, ...)                                            \
+  SL_LOG_AT(logger, ::sl::LogLevel::Warning, format __VA_OPT__(, ) __VA_ARGS__)
+#define SL_ERR(logger, format, ...)                                            \
+  SL_LOG_AT(logger, ::sl::LogLevel::Error, format __VA_OPT__(, ) __VA_ARGS__)
@@ -0,0 +1,177 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <badline/argParser.hpp>
+#include "internals.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <bit>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace ap {
+namespace {
+// Returns a mask with a bit set for every byte that is a printable,
+// non-space ASCII character. Bytes above 127 compare as negative.
+#if defined(__AVX2__)
+constexpr std::size_t blockSize = 32;
+using MaskT = std::uint32_t;
+
+MaskT printableMask(char const *const data) {
+  __m256i const v =
+      _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data));
+  __m256i const ok =
+      _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(32)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8(127), v));
+  return _mm256_movemask_epi8(ok);
+}
+#elif defined(__SSE2__)
+constexpr std::size_t blockSize = 16;
+using MaskT = std::uint16_t;
+
+MaskT printableMask(char const *const data) {
+  __m128i const v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(data));
+  __m128i const ok = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(32)),
+                                   _mm_cmplt_epi8(v, _mm_set1_epi8(127)));
+  return _mm_movemask_epi8(ok);
+}
+#else
+constexpr std::size_t blockSize = 8;
+using MaskT = std::uint8_t;
+
+MaskT printableMask(char const *const data) {
+  MaskT mask{};
+  for (std::size_t i = 0; i < blockSize; ++i)
+    if (data[i] > 32 && data[i] < 127)
+      mask |= MaskT(1) << i;
+  return mask;
+}
+#endif
+
+bool isContinuation(unsigned char const c) { return (c & 0xC0) == 0x80; }
+
+// Returns the length of the UTF-8 sequence starting at data,
+// or 0 if the sequence is malformed, overlong or encodes a surrogate.
+std::size_t utf8SequenceLength(unsigned char const *const data,
+                               std::size_t const available) {
+  unsigned char const c = data[0];
+  std::size_t length{};
+  unsigned char low = 0x80, high = 0xBF;
+
+  if (c >= 0xC2 && c <= 0xDF)
+    length = 2;
+  else if (c >= 0xE0 && c <= 0xEF) {
+    length = 3;
+    if (c == 0xE0)
+      low = 0xA0;
+    if (c == 0xED)
+      high = 0x9F;
+  } else if (c >= 0xF0 && c <= 0xF4) {
+    length = 4;
+    if (c == 0xF0)
+      low = 0x90;
+    if (c == 0xF4)
+      high = 0x8F;
+  } else
+    return 0;
+
+  if (length > available || data[1] < low || data[1] > high)
+    return 0;
+  for (std::size_t i = 2; i < length; ++i)
+    if (!isContinuation(data[i]))
+      return 0;
+  return length;
+}
+} // namespace
+
+int validateToken(std::string_view const token, bool *const ascii) {
+  auto const *const data =
+      reinterpret_cast<unsigned char const *>(token.data());
+  std::size_t const size = token.size();
+  std::size_t i = 0;
+  *ascii = true;
+
+  while (i < size) {
+    if (i + blockSize <= size) {
+      MaskT const mask = printableMask(token.data() + i);
+      if (mask == MaskT(~MaskT{})) {
+        i += blockSize;
+        continue;
+      }
+      i += std::countr_one(mask);
+    }
+
+    if (data[i] < 0x80) {
+      if (data[i] < 33 || data[i] > 126)
+        return Result::ErrorTermTokenNotValid;
+      ++i;
+      continue;
+    }
+
+    *ascii = false;
+    std::size_t const length = utf8SequenceLength(data + i, size - i);
+    if (!length)
+      return Result::ErrorTermTokenNotValid;
+    i += length;
+  }
+
+  return Result::Success;
+}
+
+bool classifyToken(ParsingDatabaseT *const database,
+                   std::string const *const token, bool const ascii) {
+  auto &info = database->tokenInfo;
+  auto const &table = database->termTable;
+  auto const isAlnum = [&table](char const c) {
+    auto const &nterms = table[static_cast<unsigned char>(c)];
+    return std::find(nterms.begin(), nterms.end(),
+                     GrammarRuleT::Identifier::Alnum) != nterms.end();
+  };
+
+  // The only derivation of a valid token which does not begin with
+  // a dash is the free value, which the grammar requires to be at least
+  // three characters long.
+  if ((*token)[0] != '-') {
+    if (token->size() < 3)
+      return false;
+    info.isFreeVal = true;
+    return true;
+  }
+
+  std::size_t const prefix = (*token)[1] == '-' ? 2 : 1;
+  if (!ascii || token->size() == prefix ||
+      !std::all_of(token->begin() + prefix, token->end(), isAlnum))
+    return false;
+
+  info.argName = token->substr(prefix);
+  info.isArgList = prefix == 1 && info.argName.size() > 1;
+  return true;
+}
+
+int fillTermTable(ParsingDatabaseT *const database) {
+  for (auto &nterms : database->termTable)
+    nterms.clear();
+  for (auto const &[nterm, term] : database->termMapping)
+    database->termTable[static_cast<unsigned char>(term)].push_back(nterm);
+  return Result::Success;
+}
+} // namespace ap
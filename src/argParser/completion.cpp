@@ -0,0 +1,250 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <badline/argParser.hpp>
+#include "internals.hpp"
+#include <algorithm>
+
+namespace ap {
+namespace {
+// Outputs the long form of the option the token names, or an empty
+// string if the token doesn't name an option.
+std::string_view findOption(ArgParserT *const handle,
+                            std::string_view const token) {
+  if (token.starts_with("--")) {
+    auto name = token.substr(2, token.find('=') - 2);
+    if (handle->allowAbbreviations) {
+      if (handle->longFormTrie.dirty)
+        buildLongFormTrie(handle);
+      if (resolveLongFormPrefix(&handle->longFormTrie, name, &name) !=
+          Result::Success)
+        return {};
+    }
+
+    auto const it = handle->options.longForm.find(std::string{name});
+    return it != handle->options.longForm.end() ? it->first
+                                                : std::string_view{};
+  }
+
+  if (token.size() < 2 || token[0] != '-' ||
+      !handle->options.shortForm.contains(token.back()))
+    return {};
+
+  auto const *const instances = handle->options.shortForm.at(token.back());
+  for (auto const &[name, values] : handle->options.longForm)
+    if (values.get() == instances)
+      return name;
+  return {};
+}
+
+// Follows the tokens before the cursor the way parse does, only as far
+// as needed to learn which handle the word at the cursor belongs to,
+// and whether it is the value of an option.
+int scanContext(ArgParserT *const handle, char const *const *const input,
+                std::size_t const begin, std::size_t const cursor,
+                CompletionStateT *const state) {
+  state->target = handle;
+  state->option.clear();
+  state->freeValue = false;
+
+  for (std::size_t i = begin; i < cursor; ++i) {
+    std::string const token = input[i];
+    auto *const target = state->target;
+
+    if (token == "--") {
+      state->freeValue = state->option.empty();
+      continue;
+    }
+    if (state->freeValue || !state->option.empty()) {
+      state->freeValue = false;
+      state->option.clear();
+      continue;
+    }
+
+    if (target->subcommands.contains(token)) {
+      if (auto r = enterSubcommand(target, token, &state->target);
+          r != Result::Success)
+        return r;
+      continue;
+    }
+
+    if (token.starts_with("--") && token.find('=') != std::string::npos)
+      continue;
+    state->option = findOption(target, token);
+  }
+  return Result::Success;
+}
+
+void completeLongForm(CompletionStateT *const state,
+                      std::string_view const word,
+                      std::vector<std::string> *const output) {
+  auto const &trie = state->target->longFormTrie;
+  std::string_view suffix = word.substr(2);
+
+  if (state->nodeValid && word.starts_with(state->word) &&
+      state->word.starts_with("--"))
+    suffix = word.substr(state->word.size());
+  else
+    state->node = 0;
+
+  state->nodeValid =
+      descendLongFormTrie(&trie, suffix, &state->node) == Result::Success;
+  if (!state->nodeValid)
+    return;
+
+  auto const &node = trie.nodes[state->node];
+  output->resize(node.leafCount);
+  for (std::uint32_t i = 0; i < node.leafCount; ++i)
+    output->at(i).assign("--").append(trie.name(node.anyTerminal + i));
+}
+
+void completeShortForm(ArgParserT const *const handle,
+                       std::vector<std::string> *const output) {
+  std::string shortForms{};
+  for (auto const &[shortForm, _] : handle->flags.shortForm)
+    shortForms.push_back(shortForm);
+  for (auto const &[shortForm, _] : handle->options.shortForm)
+    shortForms.push_back(shortForm);
+  std::sort(shortForms.begin(), shortForms.end());
+
+  output->resize(shortForms.size());
+  for (std::size_t i = 0; i < shortForms.size(); ++i)
+    output->at(i).assign({'-', shortForms[i]});
+}
+
+// Appends the sorted words starting with the prefix, after the lead.
+void completeFromSorted(std::vector<std::string> const &words,
+                        std::string_view const lead,
+                        std::string_view const prefix,
+                        std::vector<std::string> *const output) {
+  auto it = std::lower_bound(words.begin(), words.end(), prefix);
+  for (; it != words.end() && it->starts_with(prefix); ++it) {
+    output->emplace_back();
+    output->back().assign(lead).append(*it);
+  }
+}
+
+void completeSubcommand(ArgParserT *const handle, std::string_view const word,
+                        std::vector<std::string> *const output) {
+  auto &names = handle->subcommandNames;
+  if (names.size() != handle->subcommands.size()) {
+    names.clear();
+    for (auto const &[name, _] : handle->subcommands)
+      names.push_back(name);
+    std::sort(names.begin(), names.end());
+  }
+
+  output->clear();
+  completeFromSorted(names, {}, word, output);
+}
+
+void completeValue(ArgParserT const *const handle,
+                   std::string_view const option, std::string_view const lead,
+                   std::string_view const prefix,
+                   std::vector<std::string> *const output) {
+  output->clear();
+  auto const it = handle->valueChoices.find(std::string{option});
+  if (it != handle->valueChoices.end())
+    completeFromSorted(it->second, lead, prefix, output);
+}
+
+bool sameContext(CompletionStateT const *const state,
+                 char const *const *const input, std::size_t const begin,
+                 std::size_t const cursor) {
+  if (!state->target || state->context.size() != cursor - begin)
+    return false;
+  for (std::size_t i = begin; i < cursor; ++i)
+    if (state->context[i - begin] != input[i])
+      return false;
+  return true;
+}
+} // namespace
+
+int setOptionValueChoices(ArgParserT *const handle,
+                          std::string const &argLongForm,
+                          std::vector<std::string> const &choices) {
+  if (!handle)
+    return Result::ErrorNullptrHandle;
+  if (!handle->options.longForm.contains(argLongForm))
+    return Result::ErrorArgLongFormNotValid;
+
+  auto &sorted = handle->valueChoices[argLongForm];
+  sorted = choices;
+  std::sort(sorted.begin(), sorted.end());
+  handle->completion.target = nullptr;
+  return Result::Success;
+}
+
+int complete(ArgParserT *const handle, char const *const *const input,
+             std::size_t const begin, std::size_t const end,
+             std::size_t const cursor,
+             std::vector<std::string> *const candidates) {
+  if (!handle)
+    return Result::ErrorNullptrHandle;
+  if (!input && begin != end)
+    return Result::ErrorNullptrInput;
+  if (!candidates)
+    return Result::ErrorNullptrOutput;
+  if (begin > end || cursor < begin || cursor > end)
+    return Result::ErrorBeginEndRangeNotValid;
+
+  // The context is only kept along with the target it was scanned for,
+  // so a failed scan leaves neither of them behind.
+  auto &state = handle->completion;
+  if (!sameContext(&state, input, begin, cursor)) {
+    state.context.clear();
+    state.target = nullptr;
+    state.nodeValid = false;
+    if (auto r = scanContext(handle, input, begin, cursor, &state);
+        r != Result::Success) {
+      state.target = nullptr;
+      return r;
+    }
+    state.context.assign(input + begin, input + cursor);
+  }
+
+  auto *const target = state.target;
+  std::string_view const word = cursor < end ? input[cursor] : "";
+  candidates->clear();
+  if (target->longFormTrie.dirty) {
+    buildLongFormTrie(target);
+    state.nodeValid = false;
+  }
+
+  if (!state.option.empty()) {
+    completeValue(target, state.option, {}, word, candidates);
+  } else if (state.freeValue) {
+    // A value following "--" has nothing to complete.
+  } else if (word.starts_with("--") && word.find('=') != word.npos) {
+    std::size_t const split = word.find('=') + 1;
+    completeValue(target, findOption(target, word), word.substr(0, split),
+                  word.substr(split), candidates);
+  } else if (word.starts_with("--")) {
+    completeLongForm(&state, word, candidates);
+  } else if (word == "-") {
+    completeShortForm(target, candidates);
+  } else if (!word.starts_with('-')) {
+    completeSubcommand(target, word, candidates);
+  }
+
+  state.word = word;
+  return Result::Success;
+}
+} // namespace ap
@@ -0,0 +1,314 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <badline/argParser.hpp>
+#include "internals.hpp"
+#include <charconv>
+#include <limits>
+
+namespace ap {
+namespace {
+struct UnitT {
+  std::string_view suffix;
+  std::uint64_t factor;
+};
+
+// Longer suffixes come first, so that "ms" is not taken for "m".
+constexpr UnitT durationUnits[] = {
+    {"ns", 1},          {"us", 1000},           {"ms", 1000000},
+    {"s", 1000000000},  {"m", 60000000000},     {"h", 3600000000000},
+    {"d", 86400000000000}};
+
+constexpr UnitT sizeUnits[] = {
+    {"KiB", 1ull << 10}, {"MiB", 1ull << 20}, {"GiB", 1ull << 30},
+    {"TiB", 1ull << 40}, {"kB", 1000},        {"MB", 1000000},
+    {"GB", 1000000000},  {"TB", 1000000000000}, {"K", 1ull << 10},
+    {"M", 1ull << 20},   {"G", 1ull << 30},   {"T", 1ull << 40},
+    {"B", 1}};
+
+int fail(std::size_t *const errorOffset, std::size_t const offset,
+         int const result) {
+  if (errorOffset)
+    *errorOffset = offset;
+  return result;
+}
+
+int fromCharsResult(std::errc const ec) {
+  return ec == std::errc::result_out_of_range ? Result::ErrorValueOutOfRange
+                                              : Result::ErrorValueNotValid;
+}
+
+template <typename T>
+int convertNumber(std::string_view const value, T *const output,
+                  std::size_t *const errorOffset) {
+  std::size_t const skip = value.starts_with('+') ? 1 : 0;
+  char const *const begin = value.data() + skip;
+  char const *const end = value.data() + value.size();
+  if (skip && begin != end && (*begin == '-' || *begin == '+'))
+    return fail(errorOffset, skip, Result::ErrorValueNotValid);
+
+  auto const [ptr, ec] = std::from_chars(begin, end, *output);
+  if (ec != std::errc{})
+    return fail(errorOffset, skip, fromCharsResult(ec));
+  if (ptr != end || begin == end)
+    return fail(errorOffset, ptr - value.data(), Result::ErrorValueNotValid);
+  return Result::Success;
+}
+
+template <std::size_t N>
+UnitT const *matchUnit(std::string_view const rest, UnitT const (&units)[N]) {
+  for (auto const &unit : units)
+    if (rest.starts_with(unit.suffix))
+      return &unit;
+  return nullptr;
+}
+
+int convertBool(std::string_view const value, bool *const output,
+                std::size_t *const errorOffset) {
+  for (std::string_view const v : {"true", "yes", "on", "1"})
+    if (value == v)
+      return *output = true, Result::Success;
+  for (std::string_view const v : {"false", "no", "off", "0"})
+    if (value == v)
+      return *output = false, Result::Success;
+  return fail(errorOffset, 0, Result::ErrorValueNotValid);
+}
+
+// A duration is a sequence of integers followed by units, e.g. "1h30m".
+int convertDuration(std::string_view const value, std::int64_t *const output,
+                    std::size_t *const errorOffset) {
+  std::uint64_t total{};
+  std::size_t i = 0;
+  if (value.empty())
+    return fail(errorOffset, 0, Result::ErrorValueNotValid);
+
+  while (i < value.size()) {
+    std::uint64_t amount{};
+    auto const [ptr, ec] =
+        std::from_chars(value.data() + i, value.data() + value.size(), amount);
+    if (ec != std::errc{})
+      return fail(errorOffset, i, fromCharsResult(ec));
+
+    std::size_t const unitOffset = ptr - value.data();
+    auto const *const unit = matchUnit(value.substr(unitOffset), durationUnits);
+    if (!unit)
+      return fail(errorOffset, unitOffset, Result::ErrorValueNotValid);
+
+    std::uint64_t constexpr max = std::numeric_limits<std::int64_t>::max();
+    if (amount > (max - total) / unit->factor)
+      return fail(errorOffset, i, Result::ErrorValueOutOfRange);
+
+    total += amount * unit->factor;
+    i = unitOffset + unit->suffix.size();
+  }
+
+  *output = total;
+  return Result::Success;
+}
+
+int convertSize(std::string_view const value, std::uint64_t *const output,
+                std::size_t *const errorOffset) {
+  std::uint64_t amount{};
+  auto const [ptr, ec] =
+      std::from_chars(value.data(), value.data() + value.size(), amount);
+  if (ec != std::errc{})
+    return fail(errorOffset, 0, fromCharsResult(ec));
+
+  std::size_t const unitOffset = ptr - value.data();
+  std::uint64_t factor = 1;
+  if (unitOffset != value.size()) {
+    auto const rest = value.substr(unitOffset);
+    auto const *const unit = matchUnit(rest, sizeUnits);
+    if (!unit || unit->suffix.size() != rest.size())
+      return fail(errorOffset, unitOffset, Result::ErrorValueNotValid);
+    factor = unit->factor;
+  }
+
+  if (amount > std::numeric_limits<std::uint64_t>::max() / factor)
+    return fail(errorOffset, 0, Result::ErrorValueOutOfRange);
+  *output = amount * factor;
+  return Result::Success;
+}
+
+// Outputs the value of the instance, and its conversion cache unless
+// the value is read from an attached parse result.
+int findOptionValue(ArgParserT const *const handle,
+                    std::string const &argLongForm,
+                    std::size_t const instanceIndex,
+                    std::string_view *const value,
+                    ConvertedValueT **const cache) {
+  if (handle->snapshot.data) {
+    std::span<SnapshotInstanceT const> instances{};
+    if (auto r = findSnapshotInstances(&handle->snapshot,
+                                       handle->snapshot.options, argLongForm,
+                                       &instances);
+        r != Result::Success)
+      return r;
+    if (instanceIndex >= instances.size())
+      return Result::ErrorInstanceIndexNotValid;
+    *value = snapshotValue(&handle->snapshot, instances[instanceIndex]);
+    *cache = nullptr;
+    return Result::Success;
+  }
+
+  if (!handle->options.longForm.contains(argLongForm))
+    return Result::ErrorArgLongFormNotValid;
+
+  auto const &instances = handle->options.longForm.at(argLongForm);
+  if (instanceIndex >= instances->size())
+    return Result::ErrorInstanceIndexNotValid;
+
+  auto const &instance = instances->at(instanceIndex);
+  *value = instance.value;
+  *cache = &instance.converted;
+  return Result::Success;
+}
+
+// Looks the instance up, and converts its value unless a conversion
+// of the same kind was already cached for it.
+template <typename T, typename ConvertT>
+int getConvertedValue(ArgParserT const *const handle,
+                      std::string const &argLongForm,
+                      std::size_t const instanceIndex,
+                      ConvertedValueT::Kind const kind,
+                      T ConvertedValueT::ValueT::*field, T *const output,
+                      std::size_t *const errorOffset,
+                      ConvertT const &convert) {
+  if (!handle)
+    return Result::ErrorNullptrHandle;
+  if (!output)
+    return Result::ErrorNullptrValue;
+
+  std::string_view value{};
+  ConvertedValueT *cache{};
+  if (auto r = findOptionValue(handle, argLongForm, instanceIndex, &value,
+                               &cache);
+      r != Result::Success)
+    return r;
+
+  if (cache && cache->kind.load(std::memory_order_acquire) == kind) {
+    *output = cache->value.*field;
+    return Result::Success;
+  }
+
+  T converted{};
+  if (auto r = convert(value, &converted, errorOffset); r != Result::Success)
+    return r;
+
+  auto empty = ConvertedValueT::None;
+  if (cache && cache->kind.compare_exchange_strong(
+                   empty, ConvertedValueT::Busy, std::memory_order_acquire)) {
+    cache->value.*field = converted;
+    cache->kind.store(kind, std::memory_order_release);
+  }
+  *output = converted;
+  return Result::Success;
+}
+} // namespace
+
+int getOptionInstanceInt(ArgParserT const *const handle,
+                         std::string const &argLongForm,
+                         std::size_t const instanceIndex,
+                         std::int64_t *const value,
+                         std::size_t *const errorOffset) {
+  return getConvertedValue(handle, argLongForm, instanceIndex,
+                           ConvertedValueT::Int,
+                           &ConvertedValueT::ValueT::integer, value,
+                           errorOffset, convertNumber<std::int64_t>);
+}
+
+int getOptionInstanceFloat(ArgParserT const *const handle,
+                           std::string const &argLongForm,
+                           std::size_t const instanceIndex, double *const value,
+                           std::size_t *const errorOffset) {
+  return getConvertedValue(handle, argLongForm, instanceIndex,
+                           ConvertedValueT::Float,
+                           &ConvertedValueT::ValueT::floating, value,
+                           errorOffset, convertNumber<double>);
+}
+
+int getOptionInstanceBool(ArgParserT const *const handle,
+                          std::string const &argLongForm,
+                          std::size_t const instanceIndex, bool *const value,
+                          std::size_t *const errorOffset) {
+  return getConvertedValue(handle, argLongForm, instanceIndex,
+                           ConvertedValueT::Bool,
+                           &ConvertedValueT::ValueT::boolean, value,
+                           errorOffset, convertBool);
+}
+
+int getOptionInstanceDuration(ArgParserT const *const handle,
+                              std::string const &argLongForm,
+                              std::size_t const instanceIndex,
+                              std::chrono::nanoseconds *const value,
+                              std::size_t *const errorOffset) {
+  if (!value)
+    return Result::ErrorNullptrValue;
+
+  std::int64_t ns{};
+  if (auto r = getConvertedValue(handle, argLongForm, instanceIndex,
+                                 ConvertedValueT::Duration,
+                                 &ConvertedValueT::ValueT::integer, &ns,
+                                 errorOffset, convertDuration);
+      r != Result::Success)
+    return r;
+
+  *value = std::chrono::nanoseconds{ns};
+  return Result::Success;
+}
+
+int getOptionInstanceSize(ArgParserT const *const handle,
+                          std::string const &argLongForm,
+                          std::size_t const instanceIndex,
+                          std::uint64_t *const bytes,
+                          std::size_t *const errorOffset) {
+  return getConvertedValue(handle, argLongForm, instanceIndex,
+                           ConvertedValueT::Size,
+                           &ConvertedValueT::ValueT::unsignedInt, bytes,
+                           errorOffset, convertSize);
+}
+
+// The position is only meaningful for the list of choices it was found
+// in, so it isn't cached; matching the value costs no more than checking
+// that the list is the same.
+int getOptionInstanceEnum(ArgParserT const *const handle,
+                          std::string const &argLongForm,
+                          std::size_t const instanceIndex,
+                          std::vector<std::string> const &choices,
+                          std::size_t *const choice,
+                          std::size_t *const errorOffset) {
+  if (!handle)
+    return Result::ErrorNullptrHandle;
+  if (!choice)
+    return Result::ErrorNullptrValue;
+
+  std::string_view value{};
+  ConvertedValueT *cache{};
+  if (auto r = findOptionValue(handle, argLongForm, instanceIndex, &value,
+                               &cache);
+      r != Result::Success)
+    return r;
+
+  for (std::size_t i = 0; i < choices.size(); ++i)
+    if (value == choices[i])
+      return *choice = i, Result::Success;
+  return fail(errorOffset, 0, Result::ErrorValueNotValid);
+}
+} // namespace ap
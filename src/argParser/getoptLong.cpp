@@ -0,0 +1,340 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <badline/getoptLong.h>
+#include <badline/argParser.hpp>
+#include "internals.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+extern "C" {
+char *ap_optarg = nullptr;
+int ap_optind = 1;
+int ap_opterr = 1;
+int ap_optopt = '?';
+}
+
+namespace ap {
+namespace {
+enum class OrderingT { Permute, RequireOrder, ReturnInOrder };
+
+/* Rather than exchanging the skipped non options with every option
+ * found after them, their positions are recorded, and the arguments
+ * are permuted once, when the end of the options is reached. The value
+ * of optind in between is the same, as getopt_long only permutes
+ * the arguments before it.
+ */
+struct GetoptStateT {
+  char *const *argv{};
+  int begin{};
+  int cursor{-1};
+  char const *nextChar{};
+  std::vector<int> nonOptions{};
+
+  OrderingT ordering{};
+  bool printErrors{};
+  bool colon{};
+  char const *shortForms{};
+
+  // The long options are registered on a parser, whose trie resolves
+  // their names and prefixes. Its terminals index the option table.
+  option const *longOptions{};
+  char const *optionString{};
+  std::unique_ptr<ArgParserT, void (*)(ArgParserT const *const)> parser{
+      nullptr, destroyArgParser};
+  std::vector<int> optionOfName{};
+};
+
+GetoptStateT state{};
+
+int buildLongOptions(option const *const longOptions) {
+  ArgParserT *parser{};
+  if (auto r = createArgParser(&parser); r != Result::Success)
+    return r;
+  state.parser.reset(parser);
+  state.longOptions = longOptions;
+
+  for (auto const *o = longOptions; o && o->name; ++o) {
+    std::string const name = o->name;
+    if (name.empty() || parser->flags.longForm.contains(name) ||
+        parser->options.longForm.contains(name))
+      continue;
+    auto const r = o->has_arg == no_argument ? addFlag(parser, name)
+                                             : addOption(parser, name);
+    if (r != Result::Success)
+      return r;
+  }
+
+  if (auto r = buildLongFormTrie(parser); r != Result::Success)
+    return r;
+
+  auto const &trie = parser->longFormTrie;
+  state.optionOfName.assign(trie.names.size(), -1);
+  for (auto const *o = longOptions; o && o->name; ++o) {
+    std::uint32_t index{};
+    if (findLongForm(&trie, o->name, &index) == Result::Success &&
+        state.optionOfName[index] < 0)
+      state.optionOfName[index] = o - longOptions;
+  }
+  return Result::Success;
+}
+
+int initialize(int const argc, char *const *const argv,
+               char const *optionString, option const *const longOptions) {
+  if (ap_optind == 0)
+    ap_optind = 1;
+
+  state.argv = argv;
+  state.begin = ap_optind;
+  state.cursor = ap_optind;
+  state.nextChar = nullptr;
+  state.nonOptions.clear();
+  state.nonOptions.reserve(argc);
+
+  if (longOptions != state.longOptions || !state.parser)
+    if (auto r = buildLongOptions(longOptions); r != Result::Success)
+      return r;
+  state.optionString = optionString;
+
+  if (optionString[0] == '-') {
+    state.ordering = OrderingT::ReturnInOrder;
+    ++optionString;
+  } else if (optionString[0] == '+') {
+    state.ordering = OrderingT::RequireOrder;
+    ++optionString;
+  } else {
+    state.ordering = std::getenv("POSIXLY_CORRECT") ? OrderingT::RequireOrder
+                                                    : OrderingT::Permute;
+  }
+
+  state.colon = optionString[0] == ':';
+  state.shortForms = optionString;
+  return Result::Success;
+}
+
+bool isNonOption(char const *const arg) {
+  return arg[0] != '-' || arg[1] == '\0';
+}
+
+// Moves the recorded non options after the options preceding the end
+// of the scan, keeping the order of both, and points optind at them.
+void permute(int const end) {
+  auto *const argv = const_cast<char **>(state.argv);
+  if (state.nonOptions.size()) {
+    std::vector<char *> permuted{};
+    permuted.reserve(end - state.begin);
+    std::size_t next = 0;
+    for (int i = state.begin; i < end; ++i)
+      if (next < state.nonOptions.size() && state.nonOptions[next] == i)
+        ++next;
+      else
+        permuted.push_back(argv[i]);
+    for (int const i : state.nonOptions)
+      permuted.push_back(argv[i]);
+    std::copy(permuted.begin(), permuted.end(), argv + state.begin);
+  }
+  ap_optind = end - state.nonOptions.size();
+}
+
+int finish(int const end) {
+  if (state.ordering == OrderingT::Permute)
+    permute(end);
+  else
+    ap_optind = end;
+  state.cursor = -1;
+  return -1;
+}
+
+int missingArgument() { return state.colon ? ':' : '?'; }
+
+int handleLongOption(int const argc, char *const *const argv,
+                     int *const longIndex) {
+  char const *const arg = argv[ap_optind] + 2;
+  char const *const equals = std::strchr(arg, '=');
+  std::string_view const name{arg, equals ? std::size_t(equals - arg)
+                                          : std::strlen(arg)};
+  ++ap_optind;
+
+  auto const &trie = state.parser->longFormTrie;
+  std::uint32_t node = 0;
+  int found = -1;
+  if (descendLongFormTrie(&trie, name, &node) == Result::Success) {
+    auto const &n = trie.nodes[node];
+    if (n.terminal != LongFormTrieT::noTerminal) {
+      found = state.optionOfName[n.terminal];
+    } else if (n.leafCount) {
+      // A prefix of several names is only ambiguous when the options
+      // they belong to differ; otherwise the first one is taken.
+      std::vector<int> candidates{};
+      for (std::uint32_t i = 0; i < n.leafCount; ++i)
+        candidates.push_back(state.optionOfName[n.anyTerminal + i]);
+      std::sort(candidates.begin(), candidates.end());
+      found = candidates[0];
+
+      auto const &first = state.longOptions[found];
+      for (int const c : candidates) {
+        auto const &o = state.longOptions[c];
+        if (o.has_arg != first.has_arg || o.flag != first.flag ||
+            o.val != first.val) {
+          if (state.printErrors) {
+            std::fprintf(stderr,
+                         "%s: option '--%s' is ambiguous; possibilities:",
+                         argv[0], arg);
+            for (int const c : candidates)
+              std::fprintf(stderr, " '--%s'", state.longOptions[c].name);
+            std::fputc('\n', stderr);
+          }
+          ap_optopt = 0;
+          return '?';
+        }
+      }
+    }
+  }
+
+  if (found < 0) {
+    if (state.printErrors)
+      std::fprintf(stderr, "%s: unrecognized option '--%s'\n", argv[0], arg);
+    ap_optopt = 0;
+    return '?';
+  }
+
+  auto const &o = state.longOptions[found];
+  if (equals) {
+    if (o.has_arg == no_argument) {
+      if (state.printErrors)
+        std::fprintf(stderr, "%s: option '--%s' doesn't allow an argument\n",
+                     argv[0], o.name);
+      ap_optopt = o.val;
+      return '?';
+    }
+    ap_optarg = const_cast<char *>(equals + 1);
+  } else if (o.has_arg == required_argument) {
+    if (ap_optind >= argc) {
+      if (state.printErrors)
+        std::fprintf(stderr, "%s: option '--%s' requires an argument\n",
+                     argv[0], o.name);
+      ap_optopt = o.val;
+      return missingArgument();
+    }
+    ap_optarg = argv[ap_optind++];
+  }
+
+  if (longIndex)
+    *longIndex = found;
+  if (o.flag) {
+    *o.flag = o.val;
+    return 0;
+  }
+  return o.val;
+}
+
+int handleShortOption(int const argc, char *const *const argv) {
+  char const c = *state.nextChar++;
+  char const *const spec =
+      c == ':' || c == ';' ? nullptr : std::strchr(state.shortForms, c);
+  bool const last = *state.nextChar == '\0';
+  if (last)
+    ++ap_optind;
+
+  if (!spec || !c) {
+    if (state.printErrors)
+      std::fprintf(stderr, "%s: invalid option -- '%c'\n", argv[0], c);
+    ap_optopt = c;
+    return '?';
+  }
+
+  if (spec[1] != ':')
+    return c;
+
+  if (spec[2] == ':') {
+    if (!last) {
+      ap_optarg = const_cast<char *>(state.nextChar);
+      ++ap_optind;
+    }
+  } else if (!last) {
+    ap_optarg = const_cast<char *>(state.nextChar);
+    ++ap_optind;
+  } else if (ap_optind >= argc) {
+    if (state.printErrors)
+      std::fprintf(stderr, "%s: option requires an argument -- '%c'\n",
+                   argv[0], c);
+    ap_optopt = c;
+    state.nextChar = nullptr;
+    return missingArgument();
+  } else {
+    ap_optarg = argv[ap_optind++];
+  }
+
+  state.nextChar = nullptr;
+  return c;
+}
+} // namespace
+} // namespace ap
+
+extern "C" int ap_getopt_long(int const argc, char *const argv[],
+                              char const *const optstring,
+                              option const *const longopts,
+                              int *const longindex) {
+  using namespace ap;
+  if (argc < 1 || !optstring)
+    return -1;
+
+  ap_optarg = nullptr;
+  if (ap_optind == 0 || ap_optind != state.cursor || argv != state.argv ||
+      optstring != state.optionString || longopts != state.longOptions)
+    if (initialize(argc, argv, optstring, longopts) != Result::Success)
+      return -1;
+  state.printErrors = ap_opterr && !state.colon;
+
+  if (!state.nextChar || !*state.nextChar) {
+    state.nextChar = nullptr;
+    if (state.ordering == OrderingT::Permute)
+      while (ap_optind < argc && isNonOption(argv[ap_optind]))
+        state.nonOptions.push_back(ap_optind++);
+
+    if (ap_optind < argc && !std::strcmp(argv[ap_optind], "--"))
+      return finish(ap_optind + 1);
+    if (ap_optind >= argc)
+      return finish(argc);
+
+    if (isNonOption(argv[ap_optind])) {
+      if (state.ordering == OrderingT::RequireOrder) {
+        state.cursor = -1;
+        return -1;
+      }
+      ap_optarg = argv[ap_optind++];
+      state.cursor = ap_optind;
+      return 1;
+    }
+
+    if (argv[ap_optind][1] == '-') {
+      int const r = handleLongOption(argc, argv, longindex);
+      state.cursor = ap_optind;
+      return r;
+    }
+    state.nextChar = argv[ap_optind] + 1;
+  }
+
+  int const r = handleShortOption(argc, argv);
+  state.cursor = ap_optind;
+  return r;
+}
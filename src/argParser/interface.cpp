@@ -20,6 +20,7 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
 #include <badline/argParser.hpp>
 #include "internals.hpp"
+#include <algorithm>
 
 namespace ap {
 int createArgParser(ArgParserT **const handle) {
@@ -48,6 +49,8 @@ int addFlag(ArgParserT *const handle, std::string const &argLongForm,
   if (argShortForm && handle->flags.shortForm.contains(argShortForm))
     return Result::ErrorArgShortFormNotUnique;
 
+  handle->longFormTrie.dirty = true;
+  handle->completion.target = nullptr;
   auto &shortFormDB = handle->flags.shortForm;
   auto &longFormDB = handle->flags.longForm;
   longFormDB.emplace(argLongForm,
@@ -68,6 +71,8 @@ int addOption(ArgParserT *const handle, std::string const &argLongForm,
   if (argShortForm && handle->options.shortForm.contains(argShortForm))
     return Result::ErrorArgShortFormNotUnique;
 
+  handle->longFormTrie.dirty = true;
+  handle->completion.target = nullptr;
   auto &shortFormDB = handle->options.shortForm;
   auto &longFormDB = handle->options.longForm;
   longFormDB.emplace(argLongForm,
@@ -77,6 +82,35 @@ int addOption(ArgParserT *const handle, std::string const &argLongForm,
   return Result::Success;
 }
 
+int freezeSpec(ArgParserT *const handle) {
+  if (!handle)
+    return Result::ErrorNullptrHandle;
+  return buildLongFormTrie(handle);
+}
+
+int allowLongFormAbbreviations(ArgParserT *const handle, bool const allow) {
+  if (!handle)
+    return Result::ErrorNullptrHandle;
+  handle->allowAbbreviations = allow;
+  return Result::Success;
+}
+
+int addSubcommand(ArgParserT *const handle, std::string const &name,
+                  SubcommandSpecT const &spec) {
+  if (!handle)
+    return Result::ErrorNullptrHandle;
+  if (!spec)
+    return Result::ErrorNullptrInput;
+  if (name.empty())
+    return Result::ErrorArgLongFormNotValid;
+  if (handle->subcommands.contains(name))
+    return Result::ErrorSubcommandNotUnique;
+
+  handle->subcommands.emplace(name, SubcommandT{spec, nullptr});
+  handle->completion.target = nullptr;
+  return Result::Success;
+}
+
 int parse(ArgParserT *const handle, char const *const *const input,
           std::size_t const begin, std::size_t const end) {
   if (!handle)
@@ -86,13 +120,29 @@ int parse(ArgParserT *const handle, char const *const *const input,
   if (begin >= end)
     return Result::ErrorBeginEndRangeNotValid;
 
+  handle->snapshot = {};
+  handle->activeSubcommand.clear();
+  handle->errorPosition = 0;
+  using clock_t = std::chrono::steady_clock;
+  auto *const stats = handle->collectStats ? &handle->stats : nullptr;
+  handle->database.stats = stats;
+  if (stats)
+    *stats = {};
+
   for (std::size_t i = begin; i < end; ++i) {
     handle->database.back.clear();
     handle->database.chart.clear();
     handle->database.serialized.clear();
     handle->database.tokenInfo = {};
-    std::string const token = input[i];
+    auto &token = handle->token;
+    token.assign(input[i]);
     std::size_t const pos = i - begin;
+    auto const fail = [handle, pos](int const r) {
+      handle->errorPosition = pos;
+      return r;
+    };
+    if (stats)
+      ++stats->tokensSeen;
 
     if (token == "--") {
       if (handle->currentState == StateT::HandleOptionValue)
@@ -111,31 +161,88 @@ int parse(ArgParserT *const handle, char const *const *const input,
     if (handle->currentState == StateT::HandleOptionValue ||
         handle->currentState == StateT::HandleOptionRogueValue) {
       if (token[0] == '-' &&
-          handle->currentState != StateT::HandleOptionRogueValue) {
-        handle->errorPosition = pos;
-        return Result::ErrorOptionRequiresValue;
-      }
+          handle->currentState != StateT::HandleOptionRogueValue)
+        return fail(Result::ErrorOptionRequiresValue);
       handle->targetOption->back().value = token;
       handle->currentState = StateT::ParseInputToken;
       continue;
     }
 
-    if (std::string{token}.size() == 1) {
+    if (handle->subcommands.contains(token)) {
+      ArgParserT *subcommand{};
+      if (auto r = enterSubcommand(handle, token, &subcommand);
+          r != Result::Success)
+        return fail(r);
+      handle->activeSubcommand = token;
+      if (i + 1 == end)
+        return Result::Success;
+
+      auto const r = parse(subcommand, input, i + 1, end);
+      if (r != Result::Success)
+        handle->errorPosition = pos + 1 + subcommand->errorPosition;
+      return r;
+    }
+
+    if (token.size() < 2) {
       handle->freeValues.push_back({pos, token});
       continue;
     }
 
-    if (auto r = parseCYK(&handle->database, &token); r != Result::Success)
-      return r;
-    if (auto r = tracePostorderPath(&handle->database, 0); r != Result::Success)
-      return r;
+    bool ascii{};
+    if (auto r = validateToken(token, &ascii); r != Result::Success)
+      return fail(r);
+
+    auto &db = handle->database;
+    bool const classified = classifyToken(&db, &token, ascii);
+    auto const cached =
+        classified ? nullptr : findCachedToken(&handle->tokenCache, &token);
+
+    if (cached)
+      db.tokenInfo = *cached;
+    else if (!classified) {
+      if (stats)
+        ++stats->grammarTokens;
+
+      if (auto r = parseCYK(&db, &token); r != Result::Success)
+        return fail(r);
+
+      auto start = stats ? clock_t::now() : clock_t::time_point{};
+      if (auto r = tracePostorderPath(&db, 0); r != Result::Success)
+        return fail(r);
+      if (stats) {
+        stats->tracePostorderPathNs += elapsedNs(start);
+        start = clock_t::now();
+      }
+
+      if (auto r = applySemanticActions(&db, &token); r != Result::Success)
+        return fail(r);
+      if (stats)
+        stats->applySemanticActionsNs += elapsedNs(start);
+      cacheToken(&handle->tokenCache, &token, &db.tokenInfo);
+    }
+
+    auto const start = stats ? clock_t::now() : clock_t::time_point{};
     if (auto r = updateArguments(handle, &token, pos); r != Result::Success)
-      return r;
+      return fail(r);
+    if (stats)
+      stats->updateArgumentsNs += elapsedNs(start);
   }
 
   return Result::Success;
 }
 
+int parseCommandString(ArgParserT *const handle, std::string const &input) {
+  if (!handle)
+    return Result::ErrorNullptrHandle;
+
+  auto &tokens = handle->commandTokens;
+  if (auto r = tokenize(input, &tokens); r != Result::Success)
+    return r;
+  if (tokens.argv.empty())
+    return Result::Success;
+  return parse(handle, tokens.argv.data(), 0, tokens.argv.size());
+}
+
 int getErrorPosition(ArgParserT *const handle, std::size_t *const output) {
   if (!handle)
     return Result::ErrorNullptrHandle;
@@ -145,6 +252,84 @@ int getErrorPosition(ArgParserT *const handle, std::size_t *const output) {
   return Result::Success;
 }
 
+int getLongFormSuggestion(ArgParserT *const handle, std::string *const output) {
+  if (!handle)
+    return Result::ErrorNullptrHandle;
+  if (!output)
+    return Result::ErrorNullptrOutput;
+  if (handle->longFormTrie.dirty)
+    buildLongFormTrie(handle);
+
+  auto const &name = handle->unknownLongForm;
+  std::size_t const bound = std::clamp<std::size_t>((name.size() + 1) / 2, 1, 3);
+  return suggestLongForm(&handle->longFormTrie, name, bound, output);
+}
+
+int collectParseStats(ArgParserT *const handle, bool const enable) {
+  if (!handle)
+    return Result::ErrorNullptrHandle;
+  handle->collectStats = enable;
+  return Result::Success;
+}
+
+int getParseStats(ArgParserT const *const handle, ParseStatsT *const output) {
+  if (!handle)
+    return Result::ErrorNullptrHandle;
+  if (!output)
+    return Result::ErrorNullptrOutput;
+  *output = handle->stats;
+  return Result::Success;
+}
+
+int setTokenCacheSize(ArgParserT *const handle, std::size_t const maxBytes) {
+  if (!handle)
+    return Result::ErrorNullptrHandle;
+
+  shrinkTokenCache(&handle->tokenCache, maxBytes);
+  handle->tokenCache.maxBytes = maxBytes;
+  return Result::Success;
+}
+
+int getTokenCacheHitCount(ArgParserT const *const handle,
+                          std::size_t *const count) {
+  if (!handle)
+    return Result::ErrorNullptrHandle;
+  if (!count)
+    return Result::ErrorNullptrCount;
+  *count = handle->tokenCache.hits;
+  return Result::Success;
+}
+
+int getTokenCacheMissCount(ArgParserT const *const handle,
+                           std::size_t *const count) {
+  if (!handle)
+    return Result::ErrorNullptrHandle;
+  if (!count)
+    return Result::ErrorNullptrCount;
+  *count = handle->tokenCache.misses;
+  return Result::Success;
+}
+
+int getSubcommand(ArgParserT const *const handle, std::string *const name,
+                  ArgParserT **const subcommand) {
+  if (!handle)
+    return Result::ErrorNullptrHandle;
+  if (!name || !subcommand)
+    return Result::ErrorNullptrOutput;
+
+  if (handle->snapshot.data) {
+    *name = handle->snapshot.subcommand;
+    *subcommand = handle->snapshot.subcommandParser.get();
+    return Result::Success;
+  }
+
+  *name = handle->activeSubcommand;
+  *subcommand = name->empty()
+                    ? nullptr
+                    : handle->subcommands.at(*name).parser.get();
+  return Result::Success;
+}
+
 int getFlagCount(ArgParserT const *const handle, std::string const &argLongForm,
                  std::size_t *const count) {
   if (!handle)
@@ -153,7 +338,13 @@ int getFlagCount(ArgParserT const *const handle, std::string const &argLongForm,
   if (!count)
     return Result::ErrorNullptrCount;
 
-  if (handle->flags.longForm.contains(argLongForm))
+  std::span<SnapshotInstanceT const> snapshot{};
+  if (handle->snapshot.data)
+    *count = findSnapshotInstances(&handle->snapshot, handle->snapshot.flags,
+                                   argLongForm, &snapshot) == Result::Success
+                 ? snapshot.size()
+                 : 0;
+  else if (handle->flags.longForm.contains(argLongForm))
     *count = handle->flags.longForm.at(argLongForm)->size();
   else
     *count = 0;
@@ -169,6 +360,18 @@ int getFlagInstancePosition(ArgParserT const *const handle,
     return Result::ErrorNullptrHandle;
   if (!position)
     return Result::ErrorNullptrPosition;
+  if (handle->snapshot.data) {
+    std::span<SnapshotInstanceT const> instances{};
+    if (auto r = findSnapshotInstances(&handle->snapshot,
+                                       handle->snapshot.flags, argLongForm,
+                                       &instances);
+        r != Result::Success)
+      return r;
+    if (instanceIndex >= instances.size())
+      return Result::ErrorInstanceIndexNotValid;
+    *position = instances[instanceIndex].position;
+    return Result::Success;
+  }
   if (!handle->flags.longForm.contains(argLongForm))
     return Result::ErrorArgLongFormNotValid;
 
@@ -188,7 +391,13 @@ int getOptionCount(ArgParserT const *const handle,
   if (!count)
     return Result::ErrorNullptrCount;
 
-  if (handle->options.longForm.contains(argLongForm))
+  std::span<SnapshotInstanceT const> snapshot{};
+  if (handle->snapshot.data)
+    *count = findSnapshotInstances(&handle->snapshot, handle->snapshot.options,
+                                   argLongForm, &snapshot) == Result::Success
+                 ? snapshot.size()
+                 : 0;
+  else if (handle->options.longForm.contains(argLongForm))
     *count = handle->options.longForm.at(argLongForm)->size();
   else
     *count = 0;
@@ -204,6 +413,18 @@ int getOptionInstancePosition(ArgParserT const *const handle,
     return Result::ErrorNullptrHandle;
   if (!position)
     return Result::ErrorNullptrPosition;
+  if (handle->snapshot.data) {
+    std::span<SnapshotInstanceT const> instances{};
+    if (auto r = findSnapshotInstances(&handle->snapshot,
+                                       handle->snapshot.options, argLongForm,
+                                       &instances);
+        r != Result::Success)
+      return r;
+    if (instanceIndex >= instances.size())
+      return Result::ErrorInstanceIndexNotValid;
+    *position = instances[instanceIndex].position;
+    return Result::Success;
+  }
   if (!handle->options.longForm.contains(argLongForm))
     return Result::ErrorArgLongFormNotValid;
 
@@ -223,6 +444,18 @@ int getOptionInstanceValue(ArgParserT const *const handle,
     return Result::ErrorNullptrHandle;
   if (!value)
     return Result::ErrorNullptrValue;
+  if (handle->snapshot.data) {
+    std::span<SnapshotInstanceT const> instances{};
+    if (auto r = findSnapshotInstances(&handle->snapshot,
+                                       handle->snapshot.options, argLongForm,
+                                       &instances);
+        r != Result::Success)
+      return r;
+    if (instanceIndex >= instances.size())
+      return Result::ErrorInstanceIndexNotValid;
+    *value = snapshotValue(&handle->snapshot, instances[instanceIndex]);
+    return Result::Success;
+  }
   if (!handle->options.longForm.contains(argLongForm))
     return Result::ErrorArgLongFormNotValid;
 
@@ -242,7 +475,8 @@ int getFreeValueCount(ArgParserT const *const handle,
   if (!count)
     return Result::ErrorNullptrCount;
 
-  *count = handle->freeValues.size();
+  *count = handle->snapshot.data ? handle->snapshot.freeValues.size()
+                                 : handle->freeValues.size();
   return Result::Success;
 }
 
@@ -253,6 +487,12 @@ int getFreeValueInstancePosition(ArgParserT const *const handle,
     return Result::ErrorNullptrHandle;
   if (!position)
     return Result::ErrorNullptrPosition;
+  if (handle->snapshot.data) {
+    if (instanceIndex >= handle->snapshot.freeValues.size())
+      return Result::ErrorInstanceIndexNotValid;
+    *position = handle->snapshot.freeValues[instanceIndex].position;
+    return Result::Success;
+  }
   if (instanceIndex >= handle->freeValues.size())
     return Result::ErrorInstanceIndexNotValid;
 
@@ -267,6 +507,13 @@ int getFreeValueInstanceValue(ArgParserT const *const handle,
     return Result::ErrorNullptrHandle;
   if (!value)
     return Result::ErrorNullptrValue;
+  if (handle->snapshot.data) {
+    auto const &snapshot = handle->snapshot;
+    if (instanceIndex >= snapshot.freeValues.size())
+      return Result::ErrorInstanceIndexNotValid;
+    *value = snapshotValue(&snapshot, snapshot.freeValues[instanceIndex]);
+    return Result::Success;
+  }
   if (instanceIndex >= handle->freeValues.size())
     return Result::ErrorInstanceIndexNotValid;
 
@@ -335,6 +582,36 @@ int toString(int const result, std::string *const output) {
   case ErrorOptionRequiresValue:
     *output = "ErrorOptionRequiresValue";
     break;
+  case ErrorQuoteNotTerminated:
+    *output = "ErrorQuoteNotTerminated";
+    break;
+  case ErrorEscapeNotTerminated:
+    *output = "ErrorEscapeNotTerminated";
+    break;
+  case ErrorArgLongFormAmbiguous:
+    *output = "ErrorArgLongFormAmbiguous";
+    break;
+  case ErrorSubcommandNotUnique:
+    *output = "ErrorSubcommandNotUnique";
+    break;
+  case ErrorFileAccessFailure:
+    *output = "ErrorFileAccessFailure";
+    break;
+  case ErrorSpecFormatNotValid:
+    *output = "ErrorSpecFormatNotValid";
+    break;
+  case ErrorValueNotValid:
+    *output = "ErrorValueNotValid";
+    break;
+  case ErrorValueOutOfRange:
+    *output = "ErrorValueOutOfRange";
+    break;
+  case ErrorBufferSizeNotValid:
+    *output = "ErrorBufferSizeNotValid";
+    break;
+  case ErrorParseResultNotValid:
+    *output = "ErrorParseResultNotValid";
+    break;
   default:
     return ErrorResultCodeNotValid;
   }
@@ -20,6 +20,7 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
 #include <badline/argParser.hpp>
 #include "internals.hpp"
+#include <algorithm>
 #include <list>
 
 namespace ap {
@@ -37,28 +38,27 @@ int initParseChart(ParsingDatabaseT *const database,
           input->size(), std::vector<bool>(database->grammar.size(), false)}};
 
   for (std::size_t i = 0; i < input->size(); ++i) {
-    bool validToken = false;
-    for (auto const &[nterm, term] : database->termMapping) {
-      if (term == (*input)[i]) {
-        database->back[0][i][nterm].push_back(
-            BackPtrT{.variant = 0,
-                     .splitPoint = i,
-                     .ruleLHS = RuleInfoT{.identifier = nterm,
-                                          .locationY = 0,
-                                          .locationX = i,
-                                          .begin = i,
-                                          .end = i + 1},
-                     .ruleRHS = RuleInfoT{.identifier = 0,
-                                          .locationY = 0,
-                                          .locationX = 0,
-                                          .begin = 0,
-                                          .end = 0}});
-        database->chart[0][i][nterm] = true;
-        validToken = true;
-      }
-    }
-    if (!validToken)
+    auto const &nterms =
+        database->termTable[static_cast<unsigned char>((*input)[i])];
+    if (nterms.empty())
       return Result::ErrorTermTokenNotValid;
+
+    for (auto const nterm : nterms) {
+      database->back[0][i][nterm].push_back(
+          BackPtrT{.variant = 0,
+                   .splitPoint = i,
+                   .ruleLHS = RuleInfoT{.identifier = nterm,
+                                        .locationY = 0,
+                                        .locationX = i,
+                                        .begin = i,
+                                        .end = i + 1},
+                   .ruleRHS = RuleInfoT{.identifier = 0,
+                                        .locationY = 0,
+                                        .locationX = 0,
+                                        .begin = 0,
+                                        .end = 0}});
+      database->chart[0][i][nterm] = true;
+    }
   }
 
   return Result::Success;
@@ -166,21 +166,40 @@ int handleLongArg(ArgParserT *const handle, std::size_t const position) {
   auto const &fl = handle->flags;
   auto &to = handle->targetOption;
 
-  if (op.longForm.contains(ti.argName)) {
-    op.longForm.at(ti.argName)->push_back({position, ""});
+  std::string resolved{};
+  if (!op.longForm.contains(ti.argName) && !fl.longForm.contains(ti.argName)) {
+    if (!handle->allowAbbreviations) {
+      handle->unknownLongForm = ti.argName;
+      return Result::ErrorArgLongFormNotValid;
+    }
+
+    if (handle->longFormTrie.dirty)
+      buildLongFormTrie(handle);
+
+    std::string_view match{};
+    if (auto r = resolveLongFormPrefix(&handle->longFormTrie, ti.argName,
+                                       &match);
+        r != Result::Success) {
+      handle->unknownLongForm = ti.argName;
+      return r;
+    }
+    resolved = match;
+  }
+
+  auto const &name = resolved.empty() ? ti.argName : resolved;
+
+  if (op.longForm.contains(name)) {
+    op.longForm.at(name)->push_back({position, ""});
     if (ti.argVal.size())
-      op.longForm.at(ti.argName)->back().value = ti.argVal;
+      op.longForm.at(name)->back().value = ti.argVal;
     else {
       handle->currentState = StateT::HandleOptionValue;
-      to = op.longForm.at(ti.argName).get();
+      to = op.longForm.at(name).get();
     }
   }
 
-  else if (fl.longForm.contains(ti.argName))
-    fl.longForm.at(ti.argName)->push_back({position, ""});
-
   else
-    return Result::ErrorArgLongFormNotValid;
+    fl.longForm.at(name)->push_back({position, ""});
 
   return Result::Success;
 }
@@ -210,11 +229,11 @@ int handleShortArg(ArgParserT *const handle, std::size_t const position) {
   return Result::Success;
 }
 
-int updateArguments(ArgParserT *const handle, std::string const *const token,
-                    std::size_t const position) {
-  auto const &g = handle->database.grammar;
+int applySemanticActions(ParsingDatabaseT *const database,
+                         std::string const *const token) {
+  auto const &g = database->grammar;
 
-  for (auto const &[rule, info] : handle->database.serialized) {
+  for (auto const &[rule, info] : database->serialized) {
     auto const action = g[rule][info.variant].semanticAction;
     if (action) {
       action(*token, info.ruleLHS.begin, info.ruleLHS.end, info.ruleRHS.begin,
@@ -222,6 +241,11 @@ int updateArguments(ArgParserT *const handle, std::string const *const token,
     }
   }
 
+  return Result::Success;
+}
+
+int updateArguments(ArgParserT *const handle, std::string const *const token,
+                    std::size_t const position) {
   if (handle->database.tokenInfo.isFreeVal) {
     handle->freeValues.push_back({position, *token});
     return Result::Success;
@@ -246,19 +270,55 @@ int updateArguments(ArgParserT *const handle, std::string const *const token,
   return Result::Success;
 }
 
+std::uint64_t elapsedNs(std::chrono::steady_clock::time_point const since) {
+  auto const d = std::chrono::steady_clock::now() - since;
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+}
+
+std::size_t parseChartFootprint(ParsingDatabaseT const *const database) {
+  std::size_t bytes{};
+  for (auto const &row : database->back) {
+    bytes += sizeof(row);
+    for (auto const &cell : row) {
+      bytes += sizeof(cell);
+      for (auto const &variants : cell)
+        bytes += sizeof(variants) + variants.capacity() * sizeof(BackPtrT);
+    }
+  }
+
+  for (auto const &row : database->chart) {
+    bytes += sizeof(row);
+    for (auto const &cell : row)
+      bytes += sizeof(cell) + (cell.size() + 7) / 8;
+  }
+  return bytes;
+}
+
 int parseCYK(ParsingDatabaseT *const database, std::string const *const input) {
+  using clock_t = std::chrono::steady_clock;
+  auto *const stats = database->stats;
+  auto start = stats ? clock_t::now() : clock_t::time_point{};
+
   if (auto code = initParseChart(database, input); code != Result::Success)
     return code;
 
+  if (stats) {
+    stats->initParseChartNs += elapsedNs(start);
+    start = clock_t::now();
+  }
+
   auto const &g = database->grammar;
   auto &chart = database->chart;
   auto &back = database->back;
+  std::size_t backPointers{}, cells{}, variantsTested{};
 
   for (std::size_t row = 1; row < input->size(); ++row) {
     for (std::size_t col = 0; col < input->size() - row; ++col) {
+      ++cells;
       for (std::size_t it = 0; it < row; ++it) {
         for (std::size_t nTerm = 0; nTerm < g.size(); ++nTerm) {
           back[row][col][nTerm].reserve(g[nTerm].size());
+          variantsTested += g[nTerm].size();
           for (std::size_t variant = 0; variant < g[nTerm].size(); ++variant) {
             auto const &[lhs, rhs, cb] = g[nTerm][variant];
             if (chart[it][col][lhs] && chart[row - it - 1][col + it + 1][rhs]) {
@@ -269,6 +329,7 @@ int parseCYK(ParsingDatabaseT *const database, std::string const *const input) {
                    {rhs, row - it - 1, col + it + 1, col + it + 1,
                     col + row + 1}});
               chart[row][col][nTerm] = true;
+              ++backPointers;
             }
           }
         }
@@ -276,6 +337,15 @@ int parseCYK(ParsingDatabaseT *const database, std::string const *const input) {
     }
   }
 
+  if (stats) {
+    stats->parseCYKNs += elapsedNs(start);
+    stats->cellsEvaluated += cells;
+    stats->variantsTested += variantsTested;
+    stats->backPointers += backPointers;
+    stats->peakChartBytes =
+        std::max(stats->peakChartBytes, parseChartFootprint(database));
+  }
+
   if (chart[input->size() - 1][0][GrammarRuleT::Identifier::Start])
     return Result::Success;
   return Result::ErrorStartSymbolNotDerivedFromInput;
@@ -377,6 +447,7 @@ int fillParsingDatabase(ParsingDatabaseT *const database) {
   fillParsingDatabaseWithAlphabet(database);
   fillParsingDatabaseWithDigits(database);
   fillParsingDatabaseWithMisc(database);
+  fillTermTable(database);
   createGrammar(database);
 
   return Result::Success;
@@ -396,6 +467,13 @@ int fillParsingDatabaseWithMisc(ParsingDatabaseT *const database) {
       mapping.push_back({R::NonShortArgPrefix, char(i)});
   }
 
+  // Bytes of multibyte UTF-8 sequences may only appear in values.
+  // Tokens are validated as UTF-8 before they reach the chart.
+  for (std::size_t i = 128; i < 256; ++i) {
+    mapping.push_back({R::Printable, char(i)});
+    mapping.push_back({R::NonShortArgPrefix, char(i)});
+  }
+
   for (std::size_t i = 33; i < 48; ++i)
     mapping.push_back({R::NonAlnum, char(i)});
   for (std::size_t i = 58; i < 65; ++i)
@@ -434,6 +512,80 @@ int fillParsingDatabaseWithAlphabet(ParsingDatabaseT *const database) {
   return Result::Success;
 }
 
+int enterSubcommand(ArgParserT *const handle, std::string const &name,
+                    ArgParserT **const output) {
+  auto &subcommand = handle->subcommands.at(name);
+
+  // A parser is only kept once its spec was registered in full,
+  // so that a failed spec is invoked again the next time.
+  if (!subcommand.parser) {
+    ArgParserT *created{};
+    if (auto r = createArgParser(&created); r != Result::Success)
+      return r;
+    std::unique_ptr<ArgParserT> parser{created};
+
+    if (auto r = subcommand.spec(parser.get()); r != Result::Success)
+      return r;
+    if (auto r = freezeSpec(parser.get()); r != Result::Success)
+      return r;
+    subcommand.parser = std::move(parser);
+  }
+
+  *output = subcommand.parser.get();
+  return Result::Success;
+}
+
+std::size_t tokenCacheEntrySize(TokenCacheT::EntryT const &entry) {
+  // The node overhead of the list and the lookup table is approximated,
+  // so that the limit reflects the memory actually held by the cache.
+  return sizeof(TokenCacheT::EntryT) + 8 * sizeof(void *) +
+         entry.first.size() + entry.second.argName.size() +
+         entry.second.argExt.size() + entry.second.argVal.size();
+}
+
+TokenInfoT const *findCachedToken(TokenCacheT *const cache,
+                                  std::string const *const token) {
+  if (!cache->maxBytes)
+    return nullptr;
+
+  auto const it = cache->lookup.find(*token);
+  if (it == cache->lookup.end()) {
+    ++cache->misses;
+    return nullptr;
+  }
+
+  ++cache->hits;
+  cache->entries.splice(cache->entries.begin(), cache->entries, it->second);
+  return &it->second->second;
+}
+
+int shrinkTokenCache(TokenCacheT *const cache, std::size_t const maxBytes) {
+  while (cache->usedBytes > maxBytes && cache->entries.size()) {
+    auto const &last = cache->entries.back();
+    cache->usedBytes -= tokenCacheEntrySize(last);
+    cache->lookup.erase(last.first);
+    cache->entries.pop_back();
+  }
+  return Result::Success;
+}
+
+int cacheToken(TokenCacheT *const cache, std::string const *const token,
+               TokenInfoT const *const info) {
+  if (!cache->maxBytes || cache->lookup.contains(*token))
+    return Result::Success;
+
+  TokenCacheT::EntryT entry{*token, *info};
+  std::size_t const size = tokenCacheEntrySize(entry);
+  if (size > cache->maxBytes)
+    return Result::Success;
+
+  shrinkTokenCache(cache, cache->maxBytes - size);
+  cache->entries.push_front(std::move(entry));
+  cache->lookup.emplace(cache->entries.front().first, cache->entries.begin());
+  cache->usedBytes += size;
+  return Result::Success;
+}
+
 int split(std::string const *const input, char const delimiter,
           std::pair<std::string, std::string> *const output) {
   if (!input->size())
@@ -20,8 +20,14 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
 #pragma once
 
+#include <badline/argParser.hpp>
+#include <atomic>
 #include <unordered_map>
+#include <string_view>
 #include <functional>
+#include <chrono>
+#include <array>
+#include <span>
 #include <string>
 #include <vector>
 #include <list>
@@ -37,9 +43,38 @@ enum class StateT {
   HandleRogueFreeValue
 };
 
+/* The first successful typed conversion of an instance value, so that
+ * repeated accessor calls do not parse the same text again. The const
+ * accessors may run at once, so the thread which moves the kind from None
+ * to Busy writes the value, and publishes it with the release store of
+ * its kind, after which it never changes.
+ */
+struct ConvertedValueT {
+  enum Kind : std::uint8_t { None, Int, Float, Bool, Duration, Size, Busy };
+  union ValueT {
+    std::int64_t integer{};
+    std::uint64_t unsignedInt;
+    double floating;
+    bool boolean;
+  };
+
+  std::atomic<Kind> kind{None};
+  ValueT value{};
+
+  ConvertedValueT() = default;
+  ConvertedValueT(ConvertedValueT const &o) { *this = o; }
+  ConvertedValueT &operator=(ConvertedValueT const &o) {
+    Kind const k = o.kind.load(std::memory_order_acquire);
+    kind.store(k == Busy ? None : k, std::memory_order_relaxed);
+    value = o.value;
+    return *this;
+  }
+};
+
 struct ArgInstanceInfoT {
   std::size_t position{};
   std::string value{};
+  mutable ConvertedValueT converted{};
 };
 
 struct ArgInstanceDatabaseT {
@@ -135,6 +170,9 @@ struct ParsingDatabaseT {
   using TermPairT = std::pair<NonTermId, TermId>;
   std::vector<TermPairT> termMapping{};
 
+  using TermTableT = std::array<std::vector<NonTermId>, 256>;
+  TermTableT termTable{};
+
   using GrammarRuleT = std::vector<GrammarRuleVariantT>;
   std::vector<GrammarRuleT> grammar{};
 
@@ -149,6 +187,119 @@ struct ParsingDatabaseT {
   std::list<RuleDescT> serialized{};
 
   TokenInfoT tokenInfo{};
+  ParseStatsT *stats{};
+};
+
+struct TokenCacheT {
+  using EntryT = std::pair<std::string, TokenInfoT>;
+  std::list<EntryT> entries{};
+  std::unordered_map<std::string_view, std::list<EntryT>::iterator> lookup{};
+
+  std::size_t maxBytes{};
+  std::size_t usedBytes{};
+  std::size_t hits{};
+  std::size_t misses{};
+};
+
+struct MappedFileT {
+  void *data{};
+  std::size_t size{};
+
+  MappedFileT() = default;
+  MappedFileT(MappedFileT const &) = delete;
+  MappedFileT &operator=(MappedFileT const &) = delete;
+  ~MappedFileT();
+};
+
+struct LongFormTrieT {
+  static constexpr std::uint32_t noTerminal = ~std::uint32_t{};
+
+  struct NodeT {
+    char label{};
+    std::uint32_t firstChild{};
+    std::uint32_t childCount{};
+    std::uint32_t leafCount{};
+    std::uint32_t terminal{noTerminal};
+    std::uint32_t anyTerminal{noTerminal};
+  };
+
+  struct NameT {
+    std::uint32_t offset{};
+    std::uint32_t length{};
+  };
+
+  // The views refer either to the storage below, or to a mapped spec.
+  std::span<NodeT const> nodes{};
+  std::span<NameT const> names{};
+  std::string_view pool{};
+  std::uint32_t maxLength{};
+  bool dirty{true};
+
+  std::vector<NodeT> nodeStorage{};
+  std::vector<NameT> nameStorage{};
+  std::vector<char> poolStorage{};
+  std::shared_ptr<MappedFileT const> mapping{};
+
+  std::string_view name(std::uint32_t const index) const {
+    return {pool.data() + names[index].offset, names[index].length};
+  }
+};
+
+struct SnapshotArgT {
+  std::uint32_t nameOffset{};
+  std::uint32_t nameLength{};
+  std::uint32_t firstInstance{};
+  std::uint32_t instanceCount{};
+};
+
+struct SnapshotInstanceT {
+  std::uint64_t position{};
+  std::uint32_t valueOffset{};
+  std::uint32_t valueLength{};
+};
+
+// A read-only view of parse results serialized by saveParseResult.
+// The flags and the options are sorted by name, and the instances
+// of every argument are stored contiguously, in the order of parsing.
+// The results of the subcommand met are attached to a handle of its own.
+struct ParseSnapshotT {
+  void const *data{};
+  std::span<SnapshotArgT const> flags{};
+  std::span<SnapshotArgT const> options{};
+  std::span<SnapshotInstanceT const> instances{};
+  std::span<SnapshotInstanceT const> freeValues{};
+  std::string_view pool{};
+  std::string_view subcommand{};
+  std::unique_ptr<ArgParserT> subcommandParser{};
+};
+
+// The outcome of the last completion query. When only the word being
+// completed changes, the preceding tokens are not scanned again, and
+// a long form extending the previous one continues from the trie node
+// reached by it.
+struct CompletionStateT {
+  std::vector<std::string> context{};
+  ArgParserT *target{};
+  std::string option{};
+  bool freeValue{};
+
+  std::string word{};
+  std::uint32_t node{};
+  bool nodeValid{};
+};
+
+// The input ends in its last token when no blank follows it, as while the
+// token is still being typed.
+struct CommandTokensT {
+  std::string arena{};
+  std::vector<std::size_t> offsets{};
+  std::vector<char const *> argv{};
+  bool endsInToken{};
+};
+
+struct SubcommandT {
+  SubcommandSpecT spec{};
+  std::unique_ptr<ArgParserT> parser{};
 };
 
 struct ArgParserT {
@@ -157,9 +308,27 @@ struct ArgParserT {
   ArgInstanceDatabaseT flags{};
 
   ParsingDatabaseT database{};
+  TokenCacheT tokenCache{};
+  ParseStatsT stats{};
+  bool collectStats{};
+
+  CommandTokensT commandTokens{};
+  std::string token{};
+
+  std::unordered_map<std::string, SubcommandT> subcommands{};
+  std::string activeSubcommand{};
+
+  LongFormTrieT longFormTrie{};
+  bool allowAbbreviations{};
+  std::string unknownLongForm{};
   StateT currentState{};
   ModeT mode{};
 
+  ParseSnapshotT snapshot{};
+  std::unordered_map<std::string, std::vector<std::string>> valueChoices{};
+  std::vector<std::string> subcommandNames{};
+  CompletionStateT completion{};
+
   std::vector<ArgInstanceInfoT> *targetOption{};
   std::size_t errorPosition{};
 };
@@ -168,17 +337,57 @@ struct ArgParserT {
 namespace ap {
 int updateArguments(ArgParserT *const handle, std::string const *const token,
                     std::size_t const position);
+int applySemanticActions(ParsingDatabaseT *const database,
+                         std::string const *const token);
 int tracePostorderPath(ParsingDatabaseT *const database,
                        std::size_t const variant);
 int initParseChart(ParsingDatabaseT *const database,
                    std::string const *const input);
 int parseCYK(ParsingDatabaseT *const database, std::string const *const input);
+std::size_t parseChartFootprint(ParsingDatabaseT const *const database);
+std::uint64_t elapsedNs(std::chrono::steady_clock::time_point const since);
 
 int fillParsingDatabaseWithAlphabet(ParsingDatabaseT *const database);
 int fillParsingDatabaseWithDigits(ParsingDatabaseT *const database);
 int fillParsingDatabaseWithMisc(ParsingDatabaseT *const database);
 int fillParsingDatabase(ParsingDatabaseT *const database);
 
+TokenInfoT const *findCachedToken(TokenCacheT *const cache,
+                                  std::string const *const token);
+int cacheToken(TokenCacheT *const cache, std::string const *const token,
+               TokenInfoT const *const info);
+int shrinkTokenCache(TokenCacheT *const cache, std::size_t const maxBytes);
+
+int tokenize(std::string_view const input, CommandTokensT *const output);
+
+int validateToken(std::string_view const token, bool *const ascii);
+bool classifyToken(ParsingDatabaseT *const database,
+                   std::string const *const token, bool const ascii);
+int fillTermTable(ParsingDatabaseT *const database);
+
+int buildLongFormTrie(ArgParserT *const handle);
+int findLongForm(LongFormTrieT const *const trie, std::string_view const name,
+                 std::uint32_t *const index);
+int resolveLongFormPrefix(LongFormTrieT const *const trie,
+                          std::string_view const prefix,
+                          std::string_view *const output);
+int suggestLongForm(LongFormTrieT const *const trie,
+                    std::string_view const word, std::size_t const bound,
+                    std::string *const output);
+int descendLongFormTrie(LongFormTrieT const *const trie,
+                        std::string_view const suffix,
+                        std::uint32_t *const node);
+
+int enterSubcommand(ArgParserT *const handle, std::string const &name,
+                    ArgParserT **const output);
+
+int findSnapshotInstances(ParseSnapshotT const *const snapshot,
+                          std::span<SnapshotArgT const> const args,
+                          std::string_view const name,
+                          std::span<SnapshotInstanceT const> *const output);
+std::string_view snapshotValue(ParseSnapshotT const *const snapshot,
+                               SnapshotInstanceT const &instance);
+
 int split(std::string const *const input, char const delimiter,
           std::pair<std::string, std::string> *const output);
 } // namespace ap
@@ -0,0 +1,341 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <badline/argParser.hpp>
+#include "internals.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+/* The parse result blob consists of a header followed by sections, every
+ * one of them aligned to 8 bytes and addressed by its offset from
+ * the beginning of the blob, so that it may be mapped at any address:
+ *
+ *   ResultHeaderT
+ *   SnapshotArgT[flagCount]        sorted by name
+ *   SnapshotArgT[optionCount]      sorted by name
+ *   SnapshotInstanceT[instanceCount]
+ *   SnapshotInstanceT[freeValueCount]
+ *   char[poolSize]                 names and values
+ *   ResultHeaderT...               results of the subcommand met, if any
+ *
+ * The name of the subcommand is stored in the pool. Offsets within
+ * the pool are 32 bits wide, which limits it to 4 GiB.
+ *
+ * Like the spec blob, it is only valid for the byte order it was
+ * written with.
+ */
+
+namespace ap {
+namespace {
+constexpr char resultMagic[8] = {'B', 'L', 'A', 'P', 'R', 'E', 'S', 'L'};
+constexpr std::uint32_t resultVersion = 2;
+constexpr std::uint32_t resultByteOrder = 0x01020304;
+constexpr std::size_t maxSubcommandDepth = 64;
+
+struct ResultHeaderT {
+  char magic[8]{};
+  std::uint32_t version{};
+  std::uint32_t byteOrder{};
+  std::uint64_t totalSize{};
+
+  std::uint64_t flagOffset{}, flagCount{};
+  std::uint64_t optionOffset{}, optionCount{};
+  std::uint64_t instanceOffset{}, instanceCount{};
+  std::uint64_t freeValueOffset{}, freeValueCount{};
+  std::uint64_t poolOffset{}, poolSize{};
+  std::uint64_t subcommandOffset{}, subcommandSize{};
+  std::uint32_t subcommandNameOffset{}, subcommandNameLength{};
+};
+
+std::uint64_t align(std::uint64_t const offset) { return (offset + 7) & ~7ull; }
+
+bool sectionValid(ResultHeaderT const &h, std::uint64_t const offset,
+                  std::uint64_t const count, std::uint64_t const size) {
+  return offset % 8 == 0 && offset <= h.totalSize &&
+         count <= (h.totalSize - offset) / size;
+}
+
+bool rangeValid(std::uint64_t const offset, std::uint64_t const length,
+                std::uint64_t const size) {
+  return offset <= size && length <= size - offset;
+}
+
+std::string_view argName(ParseSnapshotT const *const snapshot,
+                         SnapshotArgT const &arg) {
+  return snapshot->pool.substr(arg.nameOffset, arg.nameLength);
+}
+
+// Appends the arguments of the database, sorted by name, to the output,
+// and their instances to the instance section.
+void collectResultArgs(ArgInstanceDatabaseT const &db, std::string *const pool,
+                       std::vector<SnapshotArgT> *const output,
+                       std::vector<SnapshotInstanceT> *const instances) {
+  std::vector<std::string const *> names{};
+  names.reserve(db.longForm.size());
+  for (auto const &[name, _] : db.longForm)
+    names.push_back(&name);
+  std::sort(names.begin(), names.end(),
+            [](auto const *a, auto const *b) { return *a < *b; });
+
+  for (auto const *const name : names) {
+    auto const &values = *db.longForm.at(*name);
+    output->push_back({std::uint32_t(pool->size()),
+                       std::uint32_t(name->size()),
+                       std::uint32_t(instances->size()),
+                       std::uint32_t(values.size())});
+    pool->append(*name);
+
+    for (auto const &value : values) {
+      instances->push_back({value.position, std::uint32_t(pool->size()),
+                            std::uint32_t(value.value.size())});
+      pool->append(value.value);
+    }
+  }
+}
+
+int validateResult(void const *const data, std::size_t const size) {
+  if (size < sizeof(ResultHeaderT) ||
+      reinterpret_cast<std::uintptr_t>(data) % 8)
+    return Result::ErrorParseResultNotValid;
+
+  auto const &h = *static_cast<ResultHeaderT const *>(data);
+  if (std::memcmp(h.magic, resultMagic, sizeof(resultMagic)) ||
+      h.version != resultVersion || h.byteOrder != resultByteOrder ||
+      h.totalSize != size)
+    return Result::ErrorParseResultNotValid;
+
+  if (!sectionValid(h, h.flagOffset, h.flagCount, sizeof(SnapshotArgT)) ||
+      !sectionValid(h, h.optionOffset, h.optionCount, sizeof(SnapshotArgT)) ||
+      !sectionValid(h, h.instanceOffset, h.instanceCount,
+                    sizeof(SnapshotInstanceT)) ||
+      !sectionValid(h, h.freeValueOffset, h.freeValueCount,
+                    sizeof(SnapshotInstanceT)) ||
+      !sectionValid(h, h.poolOffset, h.poolSize, 1) ||
+      !sectionValid(h, h.subcommandOffset, h.subcommandSize, 1) ||
+      !rangeValid(h.subcommandNameOffset, h.subcommandNameLength,
+                  h.poolSize) ||
+      !h.subcommandSize != !h.subcommandNameLength)
+    return Result::ErrorParseResultNotValid;
+
+  auto const *const bytes = static_cast<char const *>(data);
+  auto const argsValid = [&](std::uint64_t const offset,
+                             std::uint64_t const count) {
+    auto const *const args =
+        reinterpret_cast<SnapshotArgT const *>(bytes + offset);
+    for (std::uint64_t i = 0; i < count; ++i)
+      if (!rangeValid(args[i].nameOffset, args[i].nameLength, h.poolSize) ||
+          !rangeValid(args[i].firstInstance, args[i].instanceCount,
+                      h.instanceCount))
+        return false;
+    return true;
+  };
+
+  auto const valuesValid = [&](std::uint64_t const offset,
+                               std::uint64_t const count) {
+    auto const *const instances =
+        reinterpret_cast<SnapshotInstanceT const *>(bytes + offset);
+    for (std::uint64_t i = 0; i < count; ++i)
+      if (!rangeValid(instances[i].valueOffset, instances[i].valueLength,
+                      h.poolSize))
+        return false;
+    return true;
+  };
+
+  if (!argsValid(h.flagOffset, h.flagCount) ||
+      !argsValid(h.optionOffset, h.optionCount) ||
+      !valuesValid(h.instanceOffset, h.instanceCount) ||
+      !valuesValid(h.freeValueOffset, h.freeValueCount))
+    return Result::ErrorParseResultNotValid;
+
+  return Result::Success;
+}
+// The results of nested subcommands are attached recursively, up to
+// a depth which bounds the recursion for a crafted buffer.
+int attachResult(ArgParserT *const handle, void const *const data,
+                 std::size_t const size, std::size_t const depth) {
+  handle->snapshot = {};
+  if (!data)
+    return Result::Success;
+  if (auto r = validateResult(data, size); r != Result::Success)
+    return r;
+
+  auto const *const bytes = static_cast<char const *>(data);
+  auto const &h = *static_cast<ResultHeaderT const *>(data);
+  auto &snapshot = handle->snapshot;
+  snapshot.data = data;
+  snapshot.flags = {
+      reinterpret_cast<SnapshotArgT const *>(bytes + h.flagOffset),
+      h.flagCount};
+  snapshot.options = {
+      reinterpret_cast<SnapshotArgT const *>(bytes + h.optionOffset),
+      h.optionCount};
+  snapshot.instances = {
+      reinterpret_cast<SnapshotInstanceT const *>(bytes + h.instanceOffset),
+      h.instanceCount};
+  snapshot.freeValues = {
+      reinterpret_cast<SnapshotInstanceT const *>(bytes + h.freeValueOffset),
+      h.freeValueCount};
+  snapshot.pool = {bytes + h.poolOffset, h.poolSize};
+  snapshot.subcommand =
+      snapshot.pool.substr(h.subcommandNameOffset, h.subcommandNameLength);
+
+  if (h.subcommandSize) {
+    if (depth == maxSubcommandDepth) {
+      handle->snapshot = {};
+      return Result::ErrorParseResultNotValid;
+    }
+
+    ArgParserT *parser{};
+    if (auto r = createArgParser(&parser); r != Result::Success) {
+      handle->snapshot = {};
+      return r;
+    }
+    snapshot.subcommandParser.reset(parser);
+    if (auto r = attachResult(parser, bytes + h.subcommandOffset,
+                              h.subcommandSize, depth + 1);
+        r != Result::Success) {
+      handle->snapshot = {};
+      return r;
+    }
+  }
+  return Result::Success;
+}
+
+} // namespace
+
+int saveParseResult(ArgParserT const *const handle, void *const buffer,
+                    std::size_t const capacity, std::size_t *const size) {
+  if (!handle)
+    return Result::ErrorNullptrHandle;
+  if (!size)
+    return Result::ErrorNullptrOutput;
+  if (handle->snapshot.data)
+    return Result::ErrorParseResultNotValid;
+
+  ArgParserT const *subcommand{};
+  std::uint64_t subcommandSize{};
+  if (!handle->activeSubcommand.empty()) {
+    subcommand = handle->subcommands.at(handle->activeSubcommand).parser.get();
+    std::size_t nestedSize{};
+    if (auto r = saveParseResult(subcommand, nullptr, 0, &nestedSize);
+        r != Result::Success)
+      return r;
+    subcommandSize = nestedSize;
+  }
+
+  std::string pool{};
+  std::vector<SnapshotArgT> flags{}, options{};
+  std::vector<SnapshotInstanceT> instances{}, freeValues{};
+  collectResultArgs(handle->flags, &pool, &flags, &instances);
+  collectResultArgs(handle->options, &pool, &options, &instances);
+
+  freeValues.reserve(handle->freeValues.size());
+  for (auto const &value : handle->freeValues) {
+    freeValues.push_back({value.position, std::uint32_t(pool.size()),
+                          std::uint32_t(value.value.size())});
+    pool.append(value.value);
+  }
+
+  ResultHeaderT h{};
+  h.subcommandNameOffset = pool.size();
+  h.subcommandNameLength = handle->activeSubcommand.size();
+  pool.append(handle->activeSubcommand);
+
+  // Every offset into the pool and the instances must fit 32 bits.
+  if (pool.size() > std::numeric_limits<std::uint32_t>::max() ||
+      instances.size() > std::numeric_limits<std::uint32_t>::max())
+    return Result::ErrorParseResultNotValid;
+
+  std::memcpy(h.magic, resultMagic, sizeof(resultMagic));
+  h.version = resultVersion;
+  h.byteOrder = resultByteOrder;
+
+  h.flagOffset = align(sizeof(ResultHeaderT));
+  h.flagCount = flags.size();
+  h.optionOffset = align(h.flagOffset + flags.size() * sizeof(SnapshotArgT));
+  h.optionCount = options.size();
+  h.instanceOffset =
+      align(h.optionOffset + options.size() * sizeof(SnapshotArgT));
+  h.instanceCount = instances.size();
+  h.freeValueOffset =
+      align(h.instanceOffset + instances.size() * sizeof(SnapshotInstanceT));
+  h.freeValueCount = freeValues.size();
+  h.poolOffset =
+      align(h.freeValueOffset + freeValues.size() * sizeof(SnapshotInstanceT));
+  h.poolSize = pool.size();
+  h.subcommandOffset = align(h.poolOffset + h.poolSize);
+  h.subcommandSize = subcommandSize;
+  h.totalSize = h.subcommandOffset + h.subcommandSize;
+
+  *size = h.totalSize;
+  if (!buffer)
+    return Result::Success;
+  if (capacity < h.totalSize)
+    return Result::ErrorBufferSizeNotValid;
+
+  auto *const bytes = static_cast<char *>(buffer);
+  std::memset(bytes, 0, h.totalSize);
+  std::memcpy(bytes, &h, sizeof(h));
+  std::copy(flags.begin(), flags.end(),
+            reinterpret_cast<SnapshotArgT *>(bytes + h.flagOffset));
+  std::copy(options.begin(), options.end(),
+            reinterpret_cast<SnapshotArgT *>(bytes + h.optionOffset));
+  std::copy(instances.begin(), instances.end(),
+            reinterpret_cast<SnapshotInstanceT *>(bytes + h.instanceOffset));
+  std::copy(freeValues.begin(), freeValues.end(),
+            reinterpret_cast<SnapshotInstanceT *>(bytes + h.freeValueOffset));
+  std::memcpy(bytes + h.poolOffset, pool.data(), pool.size());
+
+  std::size_t nestedSize{};
+  if (subcommand)
+    return saveParseResult(subcommand, bytes + h.subcommandOffset,
+                           h.subcommandSize, &nestedSize);
+  return Result::Success;
+}
+
+int attachParseResult(ArgParserT *const handle, void const *const data,
+                      std::size_t const size) {
+  if (!handle)
+    return Result::ErrorNullptrHandle;
+  return attachResult(handle, data, size, 0);
+}
+
+int findSnapshotInstances(ParseSnapshotT const *const snapshot,
+                          std::span<SnapshotArgT const> const args,
+                          std::string_view const name,
+                          std::span<SnapshotInstanceT const> *const output) {
+  auto const it = std::lower_bound(
+      args.begin(), args.end(), name,
+      [snapshot](SnapshotArgT const &arg, std::string_view const name) {
+        return argName(snapshot, arg) < name;
+      });
+  if (it == args.end() || argName(snapshot, *it) != name)
+    return Result::ErrorArgLongFormNotValid;
+
+  *output = snapshot->instances.subspan(it->firstInstance, it->instanceCount);
+  return Result::Success;
+}
+
+std::string_view snapshotValue(ParseSnapshotT const *const snapshot,
+                               SnapshotInstanceT const &instance) {
+  return snapshot->pool.substr(instance.valueOffset, instance.valueLength);
+}
+} // namespace ap
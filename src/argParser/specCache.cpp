@@ -0,0 +1,335 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <badline/argParser.hpp>
+#include "internals.hpp"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+/* The spec blob consists of a header followed by sections, every one of
+ * them aligned to 8 bytes and addressed by its offset from the beginning
+ * of the blob:
+ *
+ *   SpecHeaderT
+ *   SpecArgT[argCount]             registered flags and options
+ *   LongFormTrieT::NodeT[nodeCount]
+ *   LongFormTrieT::NameT[nameCount]
+ *   char[poolSize]                 long forms referenced by the trie names
+ *
+ * The blob is only valid for the byte order and the layout it was written
+ * with, which the header records.
+ */
+
+namespace ap {
+namespace {
+constexpr char specMagic[8] = {'B', 'L', 'A', 'P', 'S', 'P', 'E', 'C'};
+constexpr std::uint32_t specVersion = 1;
+constexpr std::uint32_t specByteOrder = 0x01020304;
+
+struct SpecHeaderT {
+  char magic[8]{};
+  std::uint32_t version{};
+  std::uint32_t byteOrder{};
+  std::uint32_t nodeSize{};
+  std::uint32_t trieMaxLength{};
+  std::uint64_t totalSize{};
+
+  std::uint64_t argOffset{}, argCount{};
+  std::uint64_t nodeOffset{}, nodeCount{};
+  std::uint64_t nameOffset{}, nameCount{};
+  std::uint64_t poolOffset{}, poolSize{};
+};
+
+struct SpecArgT {
+  std::uint32_t name{};
+  std::uint8_t isOption{};
+  char shortForm{};
+  std::uint16_t reserved{};
+};
+
+std::uint64_t align(std::uint64_t const offset) { return (offset + 7) & ~7ull; }
+
+bool sectionValid(SpecHeaderT const &h, std::uint64_t const offset,
+                  std::uint64_t const count, std::uint64_t const size) {
+  return offset % 8 == 0 && offset <= h.totalSize &&
+         count <= (h.totalSize - offset) / size;
+}
+
+/* The trie is walked from the root. Children are stored after their
+ * parent, and every node but the root is the child of exactly one node,
+ * so the nodes form a tree of a known depth. The names below a node are
+ * numbered from its anyTerminal on, within the range of its parent, and
+ * spell its label at its depth, so that every name is the terminal of the
+ * one node its path leads to.
+ */
+bool validateTrie(SpecHeaderT const &h,
+                  LongFormTrieT::NodeT const *const nodes,
+                  LongFormTrieT::NameT const *const names,
+                  char const *const pool) {
+  using NodeT = LongFormTrieT::NodeT;
+  std::vector<std::uint32_t> depth(h.nodeCount, 0);
+  std::vector<bool> reached(h.nodeCount, false);
+  std::vector<bool> named(h.nameCount, false);
+  std::uint32_t maxDepth{};
+  reached[0] = true;
+
+  for (std::uint64_t i = 0; i < h.nodeCount; ++i) {
+    NodeT const &n = nodes[i];
+    if (!reached[i] || (n.childCount && n.firstChild <= i) ||
+        n.firstChild > h.nodeCount ||
+        n.childCount > h.nodeCount - n.firstChild)
+      return false;
+
+    bool const terminal = n.terminal != LongFormTrieT::noTerminal;
+    std::uint64_t leaves = terminal;
+    for (std::uint32_t c = n.firstChild; c < n.firstChild + n.childCount;
+         ++c) {
+      if (reached[c] ||
+          (c > n.firstChild && nodes[c - 1].label >= nodes[c].label))
+        return false;
+      reached[c] = true;
+      depth[c] = depth[i] + 1;
+      leaves += nodes[c].leafCount;
+    }
+
+    if (n.leafCount != leaves ||
+        (leaves && (n.anyTerminal >= h.nameCount ||
+                    leaves > h.nameCount - n.anyTerminal)) ||
+        (!leaves && n.anyTerminal != LongFormTrieT::noTerminal))
+      return false;
+    std::uint64_t const end = std::uint64_t(n.anyTerminal) + leaves;
+
+    if (terminal && (n.terminal < n.anyTerminal || n.terminal >= end ||
+                     names[n.terminal].length != depth[i] ||
+                     named[n.terminal]))
+      return false;
+    if (terminal)
+      named[n.terminal] = true;
+
+    for (std::uint32_t c = n.firstChild; c < n.firstChild + n.childCount;
+         ++c)
+      if (nodes[c].anyTerminal < n.anyTerminal ||
+          nodes[c].anyTerminal + std::uint64_t(nodes[c].leafCount) > end)
+        return false;
+
+    for (std::uint64_t k = n.anyTerminal; i && k < end; ++k)
+      if (names[k].length < depth[i] ||
+          pool[names[k].offset + depth[i] - 1] != n.label)
+        return false;
+    maxDepth = std::max(maxDepth, depth[i]);
+  }
+  return maxDepth == h.trieMaxLength &&
+         std::find(named.begin(), named.end(), false) == named.end();
+}
+
+int validateSpec(void const *const data, std::size_t const size) {
+  if (size < sizeof(SpecHeaderT))
+    return Result::ErrorSpecFormatNotValid;
+
+  auto const &h = *static_cast<SpecHeaderT const *>(data);
+  if (std::memcmp(h.magic, specMagic, sizeof(specMagic)) ||
+      h.version != specVersion || h.byteOrder != specByteOrder ||
+      h.nodeSize != sizeof(LongFormTrieT::NodeT) || h.totalSize != size)
+    return Result::ErrorSpecFormatNotValid;
+
+  if (!sectionValid(h, h.argOffset, h.argCount, sizeof(SpecArgT)) ||
+      !sectionValid(h, h.nodeOffset, h.nodeCount,
+                    sizeof(LongFormTrieT::NodeT)) ||
+      !sectionValid(h, h.nameOffset, h.nameCount,
+                    sizeof(LongFormTrieT::NameT)) ||
+      !sectionValid(h, h.poolOffset, h.poolSize, 1))
+    return Result::ErrorSpecFormatNotValid;
+
+  auto const *const bytes = static_cast<char const *>(data);
+  auto const *const names =
+      reinterpret_cast<LongFormTrieT::NameT const *>(bytes + h.nameOffset);
+  for (std::uint64_t i = 0; i < h.nameCount; ++i)
+    if (names[i].offset > h.poolSize ||
+        names[i].length > h.poolSize - names[i].offset)
+      return Result::ErrorSpecFormatNotValid;
+
+  auto const *const nodes =
+      reinterpret_cast<LongFormTrieT::NodeT const *>(bytes + h.nodeOffset);
+  if (!h.nodeCount || !validateTrie(h, nodes, names, bytes + h.poolOffset))
+    return Result::ErrorSpecFormatNotValid;
+
+  // Every name of the trie is the long form of exactly one argument, so
+  // that a name the trie resolves is always registered.
+  auto const *const args =
+      reinterpret_cast<SpecArgT const *>(bytes + h.argOffset);
+  if (h.argCount != h.nameCount)
+    return Result::ErrorSpecFormatNotValid;
+  std::vector<bool> used(h.nameCount, false);
+  for (std::uint64_t i = 0; i < h.argCount; ++i) {
+    if (args[i].name >= h.nameCount || used[args[i].name])
+      return Result::ErrorSpecFormatNotValid;
+    used[args[i].name] = true;
+  }
+
+  return Result::Success;
+}
+
+int collectSpecArgs(ArgParserT *const handle, ArgInstanceDatabaseT const &db,
+                    bool const isOption, std::vector<SpecArgT> *const output) {
+  std::unordered_map<std::vector<ArgInstanceInfoT> const *, char> shortForms{};
+  for (auto const &[shortForm, instances] : db.shortForm)
+    shortForms.emplace(instances, shortForm);
+
+  for (auto const &[name, instances] : db.longForm) {
+    SpecArgT arg{};
+    if (auto r = findLongForm(&handle->longFormTrie, name, &arg.name);
+        r != Result::Success)
+      return r;
+    arg.isOption = isOption;
+    if (auto const it = shortForms.find(instances.get());
+        it != shortForms.end())
+      arg.shortForm = it->second;
+    output->push_back(arg);
+  }
+  return Result::Success;
+}
+} // namespace
+
+MappedFileT::~MappedFileT() {
+  if (data)
+    munmap(data, size);
+}
+
+int saveSpec(ArgParserT *const handle, std::string const &path) {
+  if (!handle)
+    return Result::ErrorNullptrHandle;
+  if (handle->longFormTrie.dirty)
+    buildLongFormTrie(handle);
+
+  std::vector<SpecArgT> args{};
+  if (auto r = collectSpecArgs(handle, handle->flags, false, &args);
+      r != Result::Success)
+    return r;
+  if (auto r = collectSpecArgs(handle, handle->options, true, &args);
+      r != Result::Success)
+    return r;
+
+  auto const &trie = handle->longFormTrie;
+  SpecHeaderT h{};
+  std::memcpy(h.magic, specMagic, sizeof(specMagic));
+  h.version = specVersion;
+  h.byteOrder = specByteOrder;
+  h.nodeSize = sizeof(LongFormTrieT::NodeT);
+  h.trieMaxLength = trie.maxLength;
+
+  h.argOffset = align(sizeof(SpecHeaderT));
+  h.argCount = args.size();
+  h.nodeOffset = align(h.argOffset + args.size() * sizeof(SpecArgT));
+  h.nodeCount = trie.nodes.size();
+  h.nameOffset = align(h.nodeOffset + trie.nodes.size_bytes());
+  h.nameCount = trie.names.size();
+  h.poolOffset = align(h.nameOffset + trie.names.size_bytes());
+  h.poolSize = trie.pool.size();
+  h.totalSize = h.poolOffset + h.poolSize;
+
+  std::vector<char> blob(h.totalSize, 0);
+  std::memcpy(blob.data(), &h, sizeof(h));
+  std::memcpy(blob.data() + h.argOffset, args.data(),
+              args.size() * sizeof(SpecArgT));
+  std::memcpy(blob.data() + h.nodeOffset, trie.nodes.data(),
+              trie.nodes.size_bytes());
+  std::memcpy(blob.data() + h.nameOffset, trie.names.data(),
+              trie.names.size_bytes());
+  std::memcpy(blob.data() + h.poolOffset, trie.pool.data(), trie.pool.size());
+
+  std::ofstream file{path, std::ios::binary | std::ios::trunc};
+  file.write(blob.data(), blob.size());
+  return file.good() ? Result::Success : Result::ErrorFileAccessFailure;
+}
+
+int loadSpec(ArgParserT *const handle, std::string const &path) {
+  if (!handle)
+    return Result::ErrorNullptrHandle;
+  if (handle->flags.longForm.size() || handle->options.longForm.size())
+    return Result::ErrorArgLongFormNotUnique;
+
+  int const fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return Result::ErrorFileAccessFailure;
+
+  struct stat info{};
+  auto mapping = std::make_shared<MappedFileT>();
+  if (fstat(fd, &info) == 0 && info.st_size > 0) {
+    mapping->size = info.st_size;
+    mapping->data =
+        mmap(nullptr, mapping->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping->data == MAP_FAILED)
+      mapping->data = nullptr;
+  }
+  close(fd);
+
+  if (!mapping->data)
+    return Result::ErrorFileAccessFailure;
+  if (auto r = validateSpec(mapping->data, mapping->size);
+      r != Result::Success)
+    return r;
+
+  auto const *const bytes = static_cast<char const *>(mapping->data);
+  auto const &h = *reinterpret_cast<SpecHeaderT const *>(bytes);
+  LongFormTrieT trie{};
+  trie.nodes = {reinterpret_cast<LongFormTrieT::NodeT const *>(
+                    bytes + h.nodeOffset),
+                h.nodeCount};
+  trie.names = {reinterpret_cast<LongFormTrieT::NameT const *>(
+                    bytes + h.nameOffset),
+                h.nameCount};
+  trie.pool = {bytes + h.poolOffset, h.poolSize};
+  trie.maxLength = h.trieMaxLength;
+  trie.mapping = std::move(mapping);
+  trie.dirty = false;
+
+  // The arguments are inserted directly into tables sized up front,
+  // without the checks of addFlag, and only handed over to the handle
+  // once all of them were inserted.
+  auto const *const args =
+      reinterpret_cast<SpecArgT const *>(bytes + h.argOffset);
+  ArgInstanceDatabaseT flags{}, options{};
+  flags.longForm.reserve(h.argCount);
+  options.longForm.reserve(h.argCount);
+
+  for (std::uint64_t i = 0; i < h.argCount; ++i) {
+    auto &db = args[i].isOption ? options : flags;
+    auto const [it, inserted] = db.longForm.emplace(
+        trie.name(args[i].name),
+        std::make_unique<std::vector<ArgInstanceInfoT>>());
+    if (!inserted)
+      return Result::ErrorSpecFormatNotValid;
+    if (args[i].shortForm &&
+        !db.shortForm.emplace(args[i].shortForm, it->second.get()).second)
+      return Result::ErrorSpecFormatNotValid;
+  }
+
+  handle->longFormTrie = std::move(trie);
+  handle->flags = std::move(flags);
+  handle->options = std::move(options);
+  handle->completion.target = nullptr;
+  return Result::Success;
+}
+} // namespace ap
@@ -0,0 +1,141 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <badline/argParser.hpp>
+#include "internals.hpp"
+#include <array>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace ap {
+namespace {
+template <std::size_t N>
+std::size_t findFirstOf(std::string_view const input, std::size_t pos,
+                        std::array<char, N> const &set) {
+#ifdef __SSE2__
+  for (; pos + 16 <= input.size(); pos += 16) {
+    __m128i const block = _mm_loadu_si128(
+        reinterpret_cast<__m128i const *>(input.data() + pos));
+    __m128i hits = _mm_setzero_si128();
+    for (char const c : set)
+      hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, _mm_set1_epi8(c)));
+    if (int const mask = _mm_movemask_epi8(hits); mask)
+      return pos + __builtin_ctz(mask);
+  }
+#endif
+
+  for (; pos < input.size(); ++pos)
+    for (char const c : set)
+      if (input[pos] == c)
+        return pos;
+  return input.size();
+}
+
+constexpr std::array<char, 6> unquotedSpecial{' ', '\t', '\n',
+                                              '\'', '"', '\\'};
+constexpr std::array<char, 2> doubleQuotedSpecial{'"', '\\'};
+
+bool isBlank(char const c) { return c == ' ' || c == '\t' || c == '\n'; }
+
+bool isDoubleQuoteEscape(char const c) {
+  return c == '$' || c == '`' || c == '"' || c == '\\' || c == '\n';
+}
+
+int readDoubleQuoted(std::string_view const input, std::size_t *const pos,
+                     std::string *const arena) {
+  std::size_t i = *pos + 1;
+
+  while (true) {
+    std::size_t const mark = findFirstOf(input, i, doubleQuotedSpecial);
+    if (mark == input.size())
+      return Result::ErrorQuoteNotTerminated;
+
+    arena->append(input.data() + i, mark - i);
+    if (input[mark] == '"') {
+      *pos = mark + 1;
+      return Result::Success;
+    }
+
+    if (mark + 1 == input.size())
+      return Result::ErrorQuoteNotTerminated;
+    if (char const next = input[mark + 1]; !isDoubleQuoteEscape(next))
+      arena->push_back('\\');
+    if (input[mark + 1] != '\n')
+      arena->push_back(input[mark + 1]);
+    i = mark + 2;
+  }
+}
+} // namespace
+
+int tokenize(std::string_view const input, CommandTokensT *const output) {
+  auto &arena = output->arena;
+  auto &offsets = output->offsets;
+  arena.clear();
+  offsets.clear();
+  output->argv.clear();
+  output->endsInToken = false;
+
+  std::size_t i = 0;
+  while (true) {
+    while (i < input.size() && isBlank(input[i]))
+      ++i;
+    if (i == input.size())
+      break;
+
+    offsets.push_back(arena.size());
+    while (i < input.size() && !isBlank(input[i])) {
+      std::size_t const mark = findFirstOf(input, i, unquotedSpecial);
+      arena.append(input.data() + i, mark - i);
+      i = mark;
+
+      if (i == input.size() || isBlank(input[i]))
+        break;
+
+      if (input[i] == '\\') {
+        if (i + 1 == input.size())
+          return Result::ErrorEscapeNotTerminated;
+        if (input[i + 1] != '\n')
+          arena.push_back(input[i + 1]);
+        i += 2;
+      }
+
+      else if (input[i] == '\'') {
+        std::size_t const close = input.find('\'', i + 1);
+        if (close == std::string_view::npos)
+          return Result::ErrorQuoteNotTerminated;
+        arena.append(input.data() + i + 1, close - i - 1);
+        i = close + 1;
+      }
+
+      else if (auto r = readDoubleQuoted(input, &i, &arena);
+               r != Result::Success)
+        return r;
+    }
+    arena.push_back('\0');
+    output->endsInToken = i == input.size();
+  }
+
+  for (auto const offset : offsets)
+    output->argv.push_back(arena.data() + offset);
+  return Result::Success;
+}
+} // namespace ap
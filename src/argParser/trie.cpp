@@ -0,0 +1,225 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <badline/argParser.hpp>
+#include "internals.hpp"
+#include <algorithm>
+
+namespace ap {
+namespace {
+// Children of a node are stored contiguously and sorted by their label,
+// so the trie of a sorted name range is built depth first.
+std::uint32_t buildTrieNode(LongFormTrieT *const trie,
+                            std::vector<std::string> const &names,
+                            std::size_t const lo, std::size_t const hi,
+                            std::size_t const depth, std::uint32_t const node) {
+  auto &nodes = trie->nodeStorage;
+  auto &pool = trie->poolStorage;
+  std::size_t first = lo;
+
+  if (names[lo].size() == depth) {
+    nodes[node].terminal = trie->nameStorage.size();
+    trie->nameStorage.push_back({static_cast<std::uint32_t>(pool.size()),
+                                 static_cast<std::uint32_t>(names[lo].size())});
+    pool.insert(pool.end(), names[lo].begin(), names[lo].end());
+    ++first;
+  }
+
+  std::vector<std::pair<std::size_t, std::size_t>> groups{};
+  for (std::size_t i = first; i < hi;) {
+    std::size_t j = i + 1;
+    while (j < hi && names[j][depth] == names[i][depth])
+      ++j;
+    groups.push_back({i, j});
+    i = j;
+  }
+
+  nodes[node].firstChild = nodes.size();
+  nodes[node].childCount = groups.size();
+  nodes[node].leafCount = hi - lo;
+  nodes.resize(nodes.size() + groups.size());
+
+  for (std::size_t g = 0; g < groups.size(); ++g) {
+    std::uint32_t const child = nodes[node].firstChild + g;
+    nodes[child].label = names[groups[g].first][depth];
+    buildTrieNode(trie, names, groups[g].first, groups[g].second, depth + 1,
+                  child);
+  }
+
+  nodes[node].anyTerminal = nodes[node].terminal != LongFormTrieT::noTerminal
+                                ? nodes[node].terminal
+                                : nodes[nodes[node].firstChild].anyTerminal;
+  return node;
+}
+
+LongFormTrieT::NodeT const *findChild(LongFormTrieT const *const trie,
+                                      LongFormTrieT::NodeT const &node,
+                                      char const label) {
+  auto const begin = trie->nodes.begin() + node.firstChild;
+  auto const end = begin + node.childCount;
+  auto const it = std::lower_bound(
+      begin, end, label,
+      [](LongFormTrieT::NodeT const &n, char const c) { return n.label < c; });
+  return it != end && it->label == label ? &*it : nullptr;
+}
+
+struct SuggestionSearchT {
+  LongFormTrieT const *trie{};
+  std::string_view word{};
+  std::size_t bound{};
+  std::vector<std::size_t> rows{};
+  std::size_t bestDistance{};
+  std::uint32_t best{LongFormTrieT::noTerminal};
+};
+
+void searchSuggestion(SuggestionSearchT *const s,
+                      LongFormTrieT::NodeT const &node,
+                      std::size_t const depth) {
+  std::size_t const width = s->word.size() + 1;
+
+  for (std::uint32_t i = 0; i < node.childCount; ++i) {
+    auto const &child = s->trie->nodes[node.firstChild + i];
+    std::size_t const *const prev = s->rows.data() + depth * width;
+    std::size_t *const row = s->rows.data() + (depth + 1) * width;
+
+    row[0] = prev[0] + 1;
+    std::size_t rowMin = row[0];
+    for (std::size_t j = 1; j < width; ++j) {
+      std::size_t const replace = prev[j - 1] + (s->word[j - 1] != child.label);
+      row[j] = std::min({row[j - 1] + 1, prev[j] + 1, replace});
+      rowMin = std::min(rowMin, row[j]);
+    }
+
+    if (child.terminal != LongFormTrieT::noTerminal &&
+        row[width - 1] < s->bestDistance) {
+      s->bestDistance = row[width - 1];
+      s->best = child.terminal;
+    }
+
+    // Distances never decrease along a path, so a subtree whose row
+    // minimum exceeds the bound cannot contain a suggestion.
+    if (rowMin <= s->bound && rowMin < s->bestDistance)
+      searchSuggestion(s, child, depth + 1);
+  }
+}
+} // namespace
+
+int buildLongFormTrie(ArgParserT *const handle) {
+  std::vector<std::string> names{};
+  names.reserve(handle->flags.longForm.size() +
+                handle->options.longForm.size());
+  for (auto const &[name, instances] : handle->flags.longForm)
+    names.push_back(name);
+  for (auto const &[name, instances] : handle->options.longForm)
+    names.push_back(name);
+
+  std::sort(names.begin(), names.end());
+  names.erase(std::unique(names.begin(), names.end()), names.end());
+
+  auto &trie = handle->longFormTrie;
+  trie = {};
+  trie.nodeStorage.reserve(names.size() * 4);
+  trie.nodeStorage.resize(1);
+  for (auto const &name : names)
+    trie.maxLength = std::max<std::uint32_t>(trie.maxLength, name.size());
+
+  if (names.size())
+    buildTrieNode(&trie, names, 0, names.size(), 0, 0);
+
+  trie.nodes = trie.nodeStorage;
+  trie.names = trie.nameStorage;
+  trie.pool = {trie.poolStorage.data(), trie.poolStorage.size()};
+  trie.dirty = false;
+  return Result::Success;
+}
+
+int findLongForm(LongFormTrieT const *const trie, std::string_view const name,
+                 std::uint32_t *const index) {
+  if (trie->nodes.empty())
+    return Result::ErrorArgLongFormNotValid;
+
+  auto const *node = &trie->nodes[0];
+  for (char const c : name)
+    if (node = findChild(trie, *node, c); !node)
+      return Result::ErrorArgLongFormNotValid;
+
+  if (node->terminal == LongFormTrieT::noTerminal)
+    return Result::ErrorArgLongFormNotValid;
+  *index = node->terminal;
+  return Result::Success;
+}
+
+int resolveLongFormPrefix(LongFormTrieT const *const trie,
+                          std::string_view const prefix,
+                          std::string_view *const output) {
+  if (trie->nodes.empty())
+    return Result::ErrorArgLongFormNotValid;
+
+  auto const *node = &trie->nodes[0];
+  for (char const c : prefix)
+    if (node = findChild(trie, *node, c); !node)
+      return Result::ErrorArgLongFormNotValid;
+
+  if (node->terminal == LongFormTrieT::noTerminal && node->leafCount > 1)
+    return Result::ErrorArgLongFormAmbiguous;
+
+  auto const index = node->terminal != LongFormTrieT::noTerminal
+                         ? node->terminal
+                         : node->anyTerminal;
+  *output = trie->name(index);
+  return Result::Success;
+}
+
+int suggestLongForm(LongFormTrieT const *const trie,
+                    std::string_view const word, std::size_t const bound,
+                    std::string *const output) {
+  output->clear();
+  if (trie->nodes.empty())
+    return Result::Success;
+
+  SuggestionSearchT s{trie, word, bound};
+  s.bestDistance = bound + 1;
+  s.rows.resize((trie->maxLength + 1) * (word.size() + 1));
+  for (std::size_t j = 0; j <= word.size(); ++j)
+    s.rows[j] = j;
+
+  searchSuggestion(&s, trie->nodes[0], 0);
+  if (s.best != LongFormTrieT::noTerminal)
+    *output = trie->name(s.best);
+  return Result::Success;
+}
+
+// Moves from the given node along the suffix. The names below a node
+// are numbered contiguously, starting with its anyTerminal.
+int descendLongFormTrie(LongFormTrieT const *const trie,
+                        std::string_view const suffix,
+                        std::uint32_t *const node) {
+  if (trie->nodes.empty())
+    return Result::ErrorArgLongFormNotValid;
+
+  auto const *current = &trie->nodes[*node];
+  for (char const c : suffix)
+    if (current = findChild(trie, *current, c); !current)
+      return Result::ErrorArgLongFormNotValid;
+
+  *node = current - trie->nodes.data();
+  return Result::Success;
+}
+} // namespace ap
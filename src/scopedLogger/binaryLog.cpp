@@ -0,0 +1,398 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <badline/scopedLogger.hpp>
+#include "internals.hpp"
+#include <charconv>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <unistd.h>
+
+namespace sl {
+namespace {
+/* A binary log starts with the magic, the version and the timestamp
+ * formats. It continues with a call site definition before the first
+ * entry of every call site, and a scope definition before the first
+ * entry logged in every scope:
+ *
+ *   'S' id:u32 level:u8 line:u32 format:str function:str file:str
+ *   'N' id:u32 name:str
+ *
+ * and with the entries themselves:
+ *
+ *   'E' id:u32 scope:u32 behavior:u8 time:i64 size:u16 args
+ *
+ * where a str is a u32 length followed by the characters, the time
+ * counts nanoseconds since the epoch, and args are the packed arguments.
+ * The scope of an entry names it, as in the text outputs, rather than the
+ * function of its call site.
+ */
+constexpr char binaryLogMagic[8] = {'B', 'L', 'S', 'L', 'B', 'I', 'N', 'L'};
+constexpr std::uint32_t binaryLogVersion = 2;
+constexpr char callSiteTag = 'S';
+constexpr char scopeTag = 'N';
+constexpr char entryTag = 'E';
+constexpr std::size_t entryHeaderSize = 1 + 4 + 4 + 1 + 8 + 2;
+
+std::mutex callSiteMutex{};
+std::uint32_t callSiteCount{};
+
+// The id is assigned under a lock, once per call site, even when several
+// threads log there for the first time at once.
+std::uint32_t registerCallSite(CallSite *const site) {
+  std::lock_guard const lock{callSiteMutex};
+  if (std::uint32_t const id = site->id.load(std::memory_order_relaxed))
+    return id;
+  std::uint32_t const id = ++callSiteCount;
+  site->id.store(id, std::memory_order_release);
+  return id;
+}
+
+template <typename T> void append(std::string *const out, T const value) {
+  out->append(reinterpret_cast<char const *>(&value), sizeof(T));
+}
+
+void appendString(std::string *const out, std::string_view const v) {
+  append(out, std::uint32_t(v.size()));
+  out->append(v);
+}
+
+// Reads the fields of a binary log, failing once they run past its end.
+struct BinaryReader {
+  std::string_view data{};
+  std::size_t pos{};
+  bool failed{};
+
+  template <typename T> T read() {
+    T value{};
+    if (failed || data.size() - pos < sizeof(T)) {
+      failed = true;
+      return value;
+    }
+    std::memcpy(&value, data.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+  }
+
+  std::string_view readBytes(std::size_t const n) {
+    if (failed || data.size() - pos < n) {
+      failed = true;
+      return {};
+    }
+    pos += n;
+    return data.substr(pos - n, n);
+  }
+
+  std::string_view readString() { return readBytes(read<std::uint32_t>()); }
+};
+
+struct CallSiteDefinition {
+  int level{};
+  std::string format{};
+};
+
+template <typename T> void appendNumber(std::string *const out, T const v) {
+  char buffer[32];
+  auto const [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), v);
+  out->append(buffer, end);
+}
+
+// Appends the packed argument at the reader, and tells whether there was
+// a valid one.
+bool appendArg(std::string *const out, BinaryReader *const r) {
+  char const type = r->read<char>();
+  switch (type) {
+  case detail::ArgType::Int:
+    appendNumber(out, r->read<std::int64_t>());
+    break;
+  case detail::ArgType::Unsigned:
+    appendNumber(out, r->read<std::uint64_t>());
+    break;
+  case detail::ArgType::Double:
+    appendNumber(out, r->read<double>());
+    break;
+  case detail::ArgType::Bool:
+    *out += r->read<bool>() ? "true" : "false";
+    break;
+  case detail::ArgType::Char:
+    *out += r->read<char>();
+    break;
+  case detail::ArgType::String:
+    *out += r->readString();
+    break;
+  default:
+    return false;
+  }
+  return !r->failed;
+}
+
+int appendCallSite(LoggerT *const l, CallSite const &site,
+                   std::uint32_t const id) {
+  std::string record{};
+  record += callSiteTag;
+  append(&record, id);
+  append(&record, std::uint8_t(site.level));
+  append(&record, site.line);
+  appendString(&record, site.format);
+  appendString(&record, site.function);
+  appendString(&record, site.file);
+  if (l->definedCallSites.size() <= id)
+    l->definedCallSites.resize(id + 1);
+  l->definedCallSites[id] = true;
+  return appendToFileSink(&l->binarySink, record, site.level);
+}
+
+// The scope names are kept by address, so they are given ids in the order
+// the file first sees them. The stack entry of the thread remembers the id
+// while the file stays the same, so that the next entries under the scope
+// don't look it up.
+int defineScope(LoggerT *const l, ThreadState *const t, int const level,
+                std::uint32_t *const id) {
+  std::size_t const depth = t->depth.load(std::memory_order_relaxed);
+  auto &cached = t->binaryScopeIds[std::min(depth, maxScopeDepth - 1)];
+  char const *const scope = currentScope(t);
+  if (cached.scope == scope && cached.generation == l->binaryLogGeneration) {
+    *id = cached.id;
+    return Result::Success;
+  }
+
+  auto const [it, added] = l->definedScopes.try_emplace(
+      scope, std::uint32_t(l->definedScopes.size() + 1));
+  *id = it->second;
+  if (added) {
+    std::string record{};
+    record += scopeTag;
+    append(&record, *id);
+    appendString(&record, scope);
+    if (int const r = appendToFileSink(&l->binarySink, record, level);
+        r != Result::Success)
+      return r;
+  }
+  cached = {scope, l->binaryLogGeneration, *id};
+  return Result::Success;
+}
+
+// Only the entry is copied under the lock, along with the definitions of
+// its call site and scope the first time they appear in the file.
+int appendBinaryEntry(LoggerT *const l, CallSite const &site,
+                      std::uint32_t const id, ThreadState *const t,
+                      int const behavior, detail::PackedArgs const &args) {
+  char entry[entryHeaderSize + detail::maxPackedArgsSize];
+  auto const flags = std::uint8_t(behavior);
+  auto const now = std::chrono::system_clock::now().time_since_epoch();
+  std::int64_t const time =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+  auto const size = std::uint16_t(args.size);
+  entry[0] = entryTag;
+  std::memcpy(entry + 1, &id, 4);
+  std::memcpy(entry + 9, &flags, 1);
+  std::memcpy(entry + 10, &time, 8);
+  std::memcpy(entry + 18, &size, 2);
+  std::memcpy(entry + entryHeaderSize, args.data, args.size);
+
+  std::lock_guard const lock{l->sinkMutex};
+  if (l->binarySink.fd < 0)
+    return Result::ErrorFileAccessFailure;
+  if (id >= l->definedCallSites.size() || !l->definedCallSites[id])
+    if (int const r = appendCallSite(l, site, id); r != Result::Success)
+      return r;
+  std::uint32_t scopeId{};
+  if (int const r = defineScope(l, t, site.level, &scopeId);
+      r != Result::Success)
+    return r;
+  std::memcpy(entry + 5, &scopeId, 4);
+  return appendToFileSink(&l->binarySink, {entry, entryHeaderSize + size},
+                          site.level);
+}
+} // namespace
+
+std::string formatPacked(std::string_view const format, char const *const args,
+                         std::size_t const size) {
+  BinaryReader r{{args, size}};
+  std::string message{};
+  for (std::size_t i = 0; i < format.size(); ++i) {
+    char const c = format[i];
+    char const next = i + 1 < format.size() ? format[i + 1] : '\0';
+    if ((c == '{' || c == '}') && next == c) {
+      message += c;
+      ++i;
+    } else if (c == '{' && next == '}') {
+      if (r.pos == size || !appendArg(&message, &r))
+        message += "{}";
+      ++i;
+    } else {
+      message += c;
+    }
+  }
+  return message;
+}
+
+namespace detail {
+int logPacked(LoggerT *const l, CallSite &site, PackedArgs const &args) {
+  if (!l)
+    return Result::ErrorNullptrParameter;
+  if (!isEntryEnabled(l, site.level))
+    return Result::Success;
+
+  // The packed arguments tell the entries of the call site apart.
+  SuppressedEntries suppressed{};
+  if (isSuppressionEnabled(l) &&
+      suppressEntry(l, &site.limiter, {args.data, args.size}, &suppressed))
+    return Result::Success;
+
+  std::uint32_t id = site.id.load(std::memory_order_acquire);
+  if (!id)
+    id = registerCallSite(&site);
+
+  auto *const t = getThreadState(l);
+  int const outputMode =
+      t->oneTimeOutputMode ? t->oneTimeOutputMode : l->outputMode.load();
+  int const behavior =
+      t->oneTimeBehavior ? t->oneTimeBehavior : l->behavior.load();
+  int result = Result::Success;
+  if (outputMode & OutputMode::BinaryFile)
+    result = appendBinaryEntry(l, site, id, t, behavior, args);
+
+  // The other outputs get the entry formatted on the spot, and log clears
+  // the one-time properties once it has used them.
+  if (!(outputMode & ~OutputMode::BinaryFile)) {
+    resetOneTimeProperties(t);
+    return result;
+  }
+  if (int const r = log(l, formatPacked(site.format, args.data, args.size),
+                        site.level, suppressed);
+      r != Result::Success)
+    result = r;
+  return result;
+}
+} // namespace detail
+
+int setBinaryLogFile(LoggerT *const l, std::string const &path) {
+  if (!l)
+    return Result::ErrorNullptrParameter;
+
+  std::lock_guard const lock{l->sinkMutex};
+  if (int const r = openFileSink(&l->binarySink, path); r != Result::Success)
+    return r;
+  if (::ftruncate(l->binarySink.fd, 0))
+    return Result::ErrorFileAccessFailure;
+
+  std::string header{binaryLogMagic, sizeof(binaryLogMagic)};
+  append(&header, binaryLogVersion);
+  appendString(&header, l->dateFormat);
+  appendString(&header, l->timeFormat);
+  l->definedCallSites.clear();
+  l->definedScopes.clear();
+  ++l->binaryLogGeneration;
+  l->binarySink.buffer.clear();
+  if (int const r = appendToFileSink(&l->binarySink, header, LogLevel::Info);
+      r != Result::Success)
+    return r;
+  return flushFileSink(&l->binarySink);
+}
+
+int flushBinaryLog(LoggerT *const l) {
+  if (!l)
+    return Result::ErrorNullptrParameter;
+  std::lock_guard const lock{l->sinkMutex};
+  return flushFileSink(&l->binarySink);
+}
+
+// An entry cut short at the end of the file, as one written by a process
+// which crashed, ends the log.
+int decodeBinaryLog(std::string const &path,
+                    std::vector<std::string> *const entries) {
+  if (!entries)
+    return Result::ErrorNullptrParameter;
+
+  std::ifstream stream{path, std::ios::binary};
+  if (!stream)
+    return Result::ErrorFileAccessFailure;
+  std::string const file{std::istreambuf_iterator<char>{stream}, {}};
+
+  BinaryReader r{file};
+  if (r.readBytes(sizeof(binaryLogMagic)) !=
+          std::string_view{binaryLogMagic, sizeof(binaryLogMagic)} ||
+      r.read<std::uint32_t>() != binaryLogVersion)
+    return Result::ErrorBinaryLogNotValid;
+  std::string const dateFormat{r.readString()};
+  std::string const timeFormat{r.readString()};
+  if (r.failed)
+    return Result::ErrorBinaryLogNotValid;
+
+  std::unordered_map<std::uint32_t, CallSiteDefinition> sites{};
+  std::unordered_map<std::uint32_t, std::string> scopes{};
+  std::vector<std::string> result{};
+  EntryComponents comps{};
+  while (r.pos < file.size()) {
+    char const tag = r.read<char>();
+    auto const id = r.read<std::uint32_t>();
+
+    if (tag == callSiteTag) {
+      CallSiteDefinition site{};
+      site.level = r.read<std::uint8_t>();
+      r.read<std::uint32_t>();
+      site.format = r.readString();
+      r.readString();
+      r.readString();
+      if (r.failed)
+        break;
+      sites[id] = std::move(site);
+      continue;
+    }
+    if (tag == scopeTag) {
+      std::string name{r.readString()};
+      if (r.failed)
+        break;
+      scopes[id] = std::move(name);
+      continue;
+    }
+    if (tag != entryTag)
+      return Result::ErrorBinaryLogNotValid;
+
+    auto const scopeId = r.read<std::uint32_t>();
+    int const behavior = r.read<std::uint8_t>();
+    auto const time = r.read<std::int64_t>();
+    auto const args = r.readBytes(r.read<std::uint16_t>());
+    if (r.failed)
+      break;
+    auto const site = sites.find(id);
+    auto const scope = scopes.find(scopeId);
+    if (site == sites.end() || scope == scopes.end())
+      return Result::ErrorBinaryLogNotValid;
+
+    using system_clock = std::chrono::system_clock;
+    system_clock::time_point const t{
+        std::chrono::duration_cast<system_clock::duration>(
+            std::chrono::nanoseconds{time})};
+    getTimestamp(t, dateFormat, timeFormat, &comps.timestamp);
+    comps.logLevel = logLevelToString(site->second.level);
+    comps.function = scope->second;
+    comps.message =
+        formatPacked(site->second.format, args.data(), args.size());
+    result.push_back(makeLogEntry(behavior, comps));
+  }
+
+  *entries = std::move(result);
+  return Result::Success;
+}
+} // namespace sl
@@ -0,0 +1,187 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <badline/scopedLogger.hpp>
+#include "internals.hpp"
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace sl {
+namespace {
+int writeAll(int const fd, char const *data, std::size_t size) {
+  while (size) {
+    ssize_t const n = ::write(fd, data, size);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n < 0)
+      return Result::ErrorFileAccessFailure;
+    data += n;
+    size -= n;
+  }
+  return Result::Success;
+}
+
+template <typename F> int reconfigureFileSink(LoggerT *const l, F const &fn) {
+  if (!l)
+    return Result::ErrorNullptrParameter;
+  return pauseWriter(l, [l, &fn] { return fn(&l->fileSink); });
+}
+} // namespace
+
+FileSink::~FileSink() {
+  if (fd < 0)
+    return;
+  flushFileSink(this);
+  ::close(fd);
+}
+
+int openFileSink(FileSink *const sink, std::string const &path) {
+  int const fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC,
+                        0644);
+  if (fd < 0)
+    return Result::ErrorFileAccessFailure;
+
+  if (sink->fd >= 0) {
+    flushFileSink(sink);
+    ::close(sink->fd);
+  }
+  sink->fd = fd;
+  sink->buffer.reserve(sink->capacity);
+  sink->lastFlush = std::chrono::steady_clock::now();
+  return Result::Success;
+}
+
+int flushFileSink(FileSink *const sink) {
+  sink->lastFlush = std::chrono::steady_clock::now();
+  if (sink->fd < 0 || sink->buffer.empty())
+    return Result::Success;
+
+  int r = writeAll(sink->fd, sink->buffer.data(), sink->buffer.size());
+  sink->buffer.clear();
+  if (r == Result::Success && sink->sync && ::fsync(sink->fd))
+    r = Result::ErrorFileAccessFailure;
+  return r;
+}
+
+int flushFileSinkIfDue(FileSink *const sink) {
+  if (sink->flushPolicy != FlushPolicy::Interval || sink->buffer.empty() ||
+      std::chrono::steady_clock::now() - sink->lastFlush <
+          std::chrono::milliseconds(sink->flushThreshold))
+    return Result::Success;
+  return flushFileSink(sink);
+}
+
+int appendToFileSink(FileSink *const sink, std::string_view const entry,
+                     int const level) {
+  if (sink->fd < 0)
+    return Result::ErrorFileAccessFailure;
+
+  int r = Result::Success;
+  if (sink->buffer.size() + entry.size() > sink->capacity)
+    r = flushFileSink(sink);
+
+  // An entry larger than the whole buffer is written out directly.
+  if (entry.size() > sink->capacity)
+    return r == Result::Success ? writeAll(sink->fd, entry.data(), entry.size())
+                                : r;
+  sink->buffer += entry;
+
+  bool flush{};
+  switch (sink->flushPolicy) {
+  case FlushPolicy::Record:
+    flush = true;
+    break;
+  case FlushPolicy::Bytes:
+    flush = sink->buffer.size() >= sink->flushThreshold;
+    break;
+  case FlushPolicy::Error:
+    flush = level == LogLevel::Error;
+    break;
+  }
+
+  if (flush)
+    return flushFileSink(sink);
+  if (int const due = flushFileSinkIfDue(sink); due != Result::Success)
+    return due;
+  return r;
+}
+
+int setLogFile(LoggerT *const l, std::string const &path) {
+  return reconfigureFileSink(l, [l, &path](FileSink *const sink) {
+    if (auto r = openFileSink(sink, path); r != Result::Success)
+      return r;
+    l->logFile = path;
+    return Result::Success;
+  });
+}
+
+int resizeLogFileBuffer(LoggerT *const l, std::size_t const size) {
+  if (!size)
+    return Result::ErrorLogBufferSizeNotValid;
+
+  return reconfigureFileSink(l, [size](FileSink *const sink) {
+    int const r = flushFileSink(sink);
+    sink->capacity = size;
+    sink->buffer.shrink_to_fit();
+    sink->buffer.reserve(size);
+    return r;
+  });
+}
+
+int setLogFileFlushPolicy(LoggerT *const l, int const policy,
+                          std::size_t const threshold) {
+  if (policy < FlushPolicy::Record || policy > FlushPolicy::Error)
+    return Result::ErrorFlushPolicyNotValid;
+
+  return reconfigureFileSink(l, [policy, threshold](FileSink *const sink) {
+    sink->flushPolicy = policy;
+    sink->flushThreshold = threshold;
+    return Result::Success;
+  });
+}
+
+int syncLogFile(LoggerT *const l, bool const v) {
+  return reconfigureFileSink(l, [v](FileSink *const sink) {
+    sink->sync = v;
+    return Result::Success;
+  });
+}
+
+int flushLogFile(LoggerT *const l) {
+  if (!l)
+    return Result::ErrorNullptrParameter;
+  if (!l->logQueue) {
+    std::lock_guard const lock{l->sinkMutex};
+    return flushFileSink(&l->fileSink);
+  }
+
+  // The writer owns the sink, so it is asked to flush it once it has
+  // written out the records queued so far, and reports how that went.
+  auto *const q = l->logQueue.get();
+  flushLogQueue(l);
+  std::size_t const request = q->fileFlushRequests.fetch_add(1) + 1;
+  std::unique_lock lock{q->progressMutex};
+  q->progress.wait(lock, [q, request] {
+    return q->fileFlushes.load(std::memory_order_acquire) >= request;
+  });
+  return q->fileFlushResult;
+}
+} // namespace sl
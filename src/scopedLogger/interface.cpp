@@ -30,39 +30,46 @@ int resizeLogBuffer(LoggerT *const l, std::size_t const size) {
   if (!size)
     return Result::ErrorLogBufferSizeNotValid;
 
-  while (l->logBuffer.entries.size() > size)
-    l->logBuffer.entries.pop_front();
-
-  l->logBuffer.maxEntries = size;
-  return Result::Success;
+  std::lock_guard const lock{l->sinkMutex};
+  return resizeTrace(&l->logBuffer, size);
 }
 
 int printTrace(LoggerT *const l) {
   std::string const indent{"  "};
   auto &s = std::cout;
+  std::string timestamp{};
+
+  std::lock_guard const lock{l->sinkMutex};
+  auto const &b = l->logBuffer;
+  for (std::size_t n = 0; n < b.count; ++n) {
+    auto const &rec = b.records[(b.first + n) % b.records.size()];
+    char const *const data = b.arena.data() + rec.offset % b.arena.size();
+    getTimestamp(rec.time, l->dateFormat, l->timeFormat, &timestamp);
 
-  for (auto const &rec : l->logBuffer.entries) {
     for (std::size_t i = 0; i < rec.depth; ++i)
       s << indent;
-    s << rec.components.timestamp << " ";
-    s << rec.components.logLevel << " ";
-    s << rec.components.function << ": ";
-    s << rec.components.message << "\n";
+    s << timestamp << " ";
+    s << logLevelToString(rec.type) << " ";
+    s.write(data, rec.functionSize) << ": ";
+    s.write(data + rec.functionSize, rec.messageSize) << "\n";
   }
 
   return Result::Success;
 }
 
-int inf(LoggerT *const l, std::string const &msg) {
-  return log(l, msg, LogLevel::Info);
+int inf(LoggerT *const l, std::string const &msg,
+        std::source_location const location) {
+  return logAtLocation(l, msg, LogLevel::Info, location);
 }
 
-int wrn(LoggerT *const l, std::string const &msg) {
-  return log(l, msg, LogLevel::Warning);
+int wrn(LoggerT *const l, std::string const &msg,
+        std::source_location const location) {
+  return logAtLocation(l, msg, LogLevel::Warning, location);
 }
 
-int err(LoggerT *const l, std::string const &msg) {
-  return log(l, msg, LogLevel::Error);
+int err(LoggerT *const l, std::string const &msg,
+        std::source_location const location) {
+  return logAtLocation(l, msg, LogLevel::Error, location);
 }
 
 int addOrRemoveBit(LoggerT *const l, bool const v, int &target, int const c) {
@@ -77,6 +84,28 @@ int addOrRemoveBit(LoggerT *const l, bool const v, int &target, int const c) {
   return Result::Success;
 }
 
+int addOrRemoveBit(LoggerT *const l, bool const v, std::atomic<int> &target,
+                   int const c) {
+  if (!l)
+    return Result::ErrorNullptrParameter;
+
+  if (v)
+    target.fetch_or(c);
+  else
+    target.fetch_and(~c);
+
+  return Result::Success;
+}
+
+// The one-time properties belong to the calling thread.
+int addOrRemoveOneTimeBit(LoggerT *const l, bool const v,
+                          int ThreadState::*const target, int const c) {
+  if (!l)
+    return Result::ErrorNullptrParameter;
+  auto *const t = copyPropertiesToOneTimeVariants(l);
+  return addOrRemoveBit(l, v, t->*target, c);
+}
+
 int outputToConsole(LoggerT *const l, bool const v) {
   return addOrRemoveBit(l, v, l->outputMode, OutputMode::Console);
 }
@@ -89,6 +118,14 @@ int outputToBuffer(LoggerT *const l, bool const v) {
   return addOrRemoveBit(l, v, l->outputMode, OutputMode::Buffer);
 }
 
+int outputToRingFile(LoggerT *const l, bool const v) {
+  return addOrRemoveBit(l, v, l->outputMode, OutputMode::RingFile);
+}
+
+int outputToBinaryFile(LoggerT *const l, bool const v) {
+  return addOrRemoveBit(l, v, l->outputMode, OutputMode::BinaryFile);
+}
+
 int logLevelInf(LoggerT *const l, bool const v) {
   return addOrRemoveBit(l, v, l->logLevel, LogLevel::Info);
 }
@@ -101,6 +138,28 @@ int logLevelErr(LoggerT *const l, bool const v) {
   return addOrRemoveBit(l, v, l->logLevel, LogLevel::Error);
 }
 
+bool isLogLevelEnabled(LoggerT *const l, int const level) {
+  return l && isEntryEnabled(l, level);
+}
+
+int setDateFormat(LoggerT *const l, std::string const &format) {
+  if (!l)
+    return Result::ErrorNullptrParameter;
+  return pauseWriter(l, [l, &format] {
+    l->dateFormat = format;
+    return Result::Success;
+  });
+}
+
+int setTimeFormat(LoggerT *const l, std::string const &format) {
+  if (!l)
+    return Result::ErrorNullptrParameter;
+  return pauseWriter(l, [l, &format] {
+    l->timeFormat = format;
+    return Result::Success;
+  });
+}
+
 int appendNewLine(LoggerT *const l, bool const v) {
   return addOrRemoveBit(l, v, l->behavior, Behavior::AppendNewLine);
 }
@@ -122,58 +181,63 @@ int prefixFunc(LoggerT *const l, bool const v) {
 }
 
 int oneTimeOutputToConsole(LoggerT *const l, bool const v) {
-  copyPropertiesToOneTimeVariants(l);
-  return addOrRemoveBit(l, v, l->oneTimeOutputMode, OutputMode::Console);
+  return addOrRemoveOneTimeBit(l, v, &ThreadState::oneTimeOutputMode,
+                               OutputMode::Console);
 }
 
 int oneTimeOutputToFile(LoggerT *const l, bool const v) {
-  copyPropertiesToOneTimeVariants(l);
-  return addOrRemoveBit(l, v, l->oneTimeOutputMode, OutputMode::File);
+  return addOrRemoveOneTimeBit(l, v, &ThreadState::oneTimeOutputMode,
+                               OutputMode::File);
 }
 
 int oneTimeOutputToBuffer(LoggerT *const l, bool const v) {
-  copyPropertiesToOneTimeVariants(l);
-  return addOrRemoveBit(l, v, l->oneTimeOutputMode, OutputMode::Buffer);
+  return addOrRemoveOneTimeBit(l, v, &ThreadState::oneTimeOutputMode,
+                               OutputMode::Buffer);
+}
+
+int oneTimeOutputToRingFile(LoggerT *const l, bool const v) {
+  return addOrRemoveOneTimeBit(l, v, &ThreadState::oneTimeOutputMode,
+                               OutputMode::RingFile);
 }
 
 int oneTimeLogLevelInf(LoggerT *const l, bool const v) {
-  copyPropertiesToOneTimeVariants(l);
-  return addOrRemoveBit(l, v, l->oneTimeLogLevel, LogLevel::Info);
+  return addOrRemoveOneTimeBit(l, v, &ThreadState::oneTimeLogLevel,
+                               LogLevel::Info);
 }
 
 int oneTimeLogLevelWrn(LoggerT *const l, bool const v) {
-  copyPropertiesToOneTimeVariants(l);
-  return addOrRemoveBit(l, v, l->oneTimeLogLevel, LogLevel::Warning);
+  return addOrRemoveOneTimeBit(l, v, &ThreadState::oneTimeLogLevel,
+                               LogLevel::Warning);
 }
 
 int oneTimeLogLevelErr(LoggerT *const l, bool const v) {
-  copyPropertiesToOneTimeVariants(l);
-  return addOrRemoveBit(l, v, l->oneTimeLogLevel, LogLevel::Error);
+  return addOrRemoveOneTimeBit(l, v, &ThreadState::oneTimeLogLevel,
+                               LogLevel::Error);
 }
 
 int oneTimeAppendNewLine(LoggerT *const l, bool const v) {
-  copyPropertiesToOneTimeVariants(l);
-  return addOrRemoveBit(l, v, l->oneTimeBehavior, Behavior::AppendNewLine);
+  return addOrRemoveOneTimeBit(l, v, &ThreadState::oneTimeBehavior,
+                               Behavior::AppendNewLine);
 }
 
 int oneTimeFlushStream(LoggerT *const l, bool const v) {
-  copyPropertiesToOneTimeVariants(l);
-  return addOrRemoveBit(l, v, l->oneTimeBehavior, Behavior::FlushStream);
+  return addOrRemoveOneTimeBit(l, v, &ThreadState::oneTimeBehavior,
+                               Behavior::FlushStream);
 }
 
 int oneTimePrefixTime(LoggerT *const l, bool const v) {
-  copyPropertiesToOneTimeVariants(l);
-  return addOrRemoveBit(l, v, l->oneTimeBehavior, Behavior::PrefixTime);
+  return addOrRemoveOneTimeBit(l, v, &ThreadState::oneTimeBehavior,
+                               Behavior::PrefixTime);
 }
 
 int oneTimePrefixLevel(LoggerT *const l, bool const v) {
-  copyPropertiesToOneTimeVariants(l);
-  return addOrRemoveBit(l, v, l->oneTimeBehavior, Behavior::PrefixLevel);
+  return addOrRemoveOneTimeBit(l, v, &ThreadState::oneTimeBehavior,
+                               Behavior::PrefixLevel);
 }
 
 int oneTimePrefixFunc(LoggerT *const l, bool const v) {
-  copyPropertiesToOneTimeVariants(l);
-  return addOrRemoveBit(l, v, l->oneTimeBehavior, Behavior::PrefixFunc);
+  return addOrRemoveOneTimeBit(l, v, &ThreadState::oneTimeBehavior,
+                               Behavior::PrefixFunc);
 }
 
 int createLogger(LoggerT **const handle, std::string const &func) {
@@ -181,15 +245,20 @@ int createLogger(LoggerT **const handle, std::string const &func) {
     return Result::ErrorNullptrParameter;
 
   if (auto ptr = new LoggerT{}; ptr) {
+    ptr->id = makeLoggerId();
+    ptr->name = func;
     *handle = ptr;
-    stepIn(ptr, func);
     return Result::Success;
   }
 
   return Result::ErrorMemoryAllocationFailure;
 }
 
-void destroyLogger(LoggerT *const handle) { delete handle; }
+void destroyLogger(LoggerT *const handle) {
+  if (handle)
+    releaseThreadState(handle);
+  delete handle;
+}
 
 UniqueLogger createLogger(std::string const &func) {
   LoggerT *handle{};
@@ -197,25 +266,32 @@ UniqueLogger createLogger(std::string const &func) {
   return {handle, destroyLogger};
 }
 
-FunctionScope::FunctionScope(LoggerT *const logger, std::string const &func) {
-  logger_ = logger;
-  if (logger_)
-    stepIn(logger_, func);
+FunctionScope::FunctionScope(LoggerT *const logger,
+                             std::string_view const func, Interned) {
+  state_ =
+      logger ? stepIn(logger, internScopeName(func), &profiled_) : nullptr;
+}
+
+FunctionScope::FunctionScope(LoggerT *const logger, char const *const func,
+                             Literal) {
+  state_ = logger ? stepIn(logger, func, &profiled_) : nullptr;
 }
 
 FunctionScope::FunctionScope(FunctionScope &&o) {
-  logger_ = o.logger_;
-  o.logger_ = nullptr;
+  state_ = o.state_;
+  profiled_ = o.profiled_;
+  o.state_ = nullptr;
 }
 
 FunctionScope &FunctionScope::operator=(FunctionScope &&o) {
-  logger_ = o.logger_;
-  o.logger_ = nullptr;
+  state_ = o.state_;
+  profiled_ = o.profiled_;
+  o.state_ = nullptr;
   return *this;
 }
 
 FunctionScope::~FunctionScope() {
-  if (logger_)
-    stepOut(logger_);
+  if (state_)
+    stepOut(state_, profiled_);
 }
 } // namespace sl
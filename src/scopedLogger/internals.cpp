@@ -20,20 +20,122 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
 #include <badline/scopedLogger.hpp>
 #include "internals.hpp"
+#include <algorithm>
+#include <functional>
 #include <iostream>
-#include <sstream>
-#include <iomanip>
 #include <chrono>
+#include <cstdint>
+#include <set>
+#include <ctime>
+#include <vector>
 
 namespace sl {
+namespace {
+// The prefix formatted for the last second, with the sub-second fields
+// zeroed, and the offsets and digit counts of those fields.
+struct TimestampCache {
+  std::string dateFormat{}, timeFormat{};
+  std::chrono::sys_seconds second{std::chrono::sys_seconds::min()};
+  std::string prefix{};
+  std::vector<std::pair<std::size_t, int>> fractions{};
+};
+
+thread_local TimestampCache timestampCache{};
+
+constexpr std::int64_t powersOfTen[] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+void appendTime(std::string *const out, std::string const &format,
+                std::tm const &time) {
+  if (format.empty())
+    return;
+
+  // A zero result is ambiguous, so the buffer is grown a few times
+  // before the field is taken to be empty.
+  std::string buffer(64, '\0');
+  for (; buffer.size() <= 4096; buffer.resize(buffer.size() * 4)) {
+    if (std::size_t const n = std::strftime(buffer.data(), buffer.size(),
+                                            format.c_str(), &time)) {
+      out->append(buffer.data(), n);
+      return;
+    }
+  }
+}
+
+void refreshTimestampCache(TimestampCache *const c,
+                           std::chrono::sys_seconds const second) {
+  std::time_t const t = second.time_since_epoch().count();
+  std::tm time{};
+  ::localtime_r(&t, &time);
+
+  c->prefix.clear();
+  c->fractions.clear();
+  std::string const format = c->dateFormat + " " + c->timeFormat;
+  std::string chunk{};
+  for (std::size_t i = 0; i < format.size(); ++i) {
+    char const next = i + 1 < format.size() ? format[i + 1] : '\0';
+    int digits{};
+    if (format[i] != '%' || !next) {
+      chunk += format[i];
+      continue;
+    } else if (next == 'N') {
+      digits = 9;
+      i += 1;
+    } else if (next >= '1' && next <= '9' && i + 2 < format.size() &&
+               format[i + 2] == 'N') {
+      digits = next - '0';
+      i += 2;
+    } else {
+      chunk += format.substr(i++, 2);
+      continue;
+    }
+
+    appendTime(&c->prefix, chunk, time);
+    chunk.clear();
+    c->fractions.emplace_back(c->prefix.size(), digits);
+    c->prefix.append(digits, '0');
+  }
+  appendTime(&c->prefix, chunk, time);
+  c->second = second;
+}
+} // namespace
+
 std::string getTimestamp(std::string const &dateF, std::string const &timeF) {
-  using clock_t = std::chrono::system_clock;
-  std::time_t currentTime{clock_t::to_time_t(clock_t::now())};
-  std::tm timeMember = *std::localtime(&currentTime);
-  std::stringstream buffer{};
-  buffer << std::put_time(&timeMember, dateF.c_str()) << " ";
-  buffer << std::put_time(&timeMember, timeF.c_str());
-  return buffer.str();
+  return getTimestamp(std::chrono::system_clock::now(), dateF, timeF);
+}
+
+std::string getTimestamp(std::chrono::system_clock::time_point const time,
+                         std::string const &dateF, std::string const &timeF) {
+  std::string timestamp{};
+  getTimestamp(time, dateF, timeF, &timestamp);
+  return timestamp;
+}
+
+// Only a change of the second or the formats calls into localtime_r and
+// strftime; otherwise the cached prefix is copied, and the sub-second
+// digits written into it.
+void getTimestamp(std::chrono::system_clock::time_point const time,
+                  std::string const &dateF, std::string const &timeF,
+                  std::string *const out) {
+  auto *const c = &timestampCache;
+  auto const second = std::chrono::floor<std::chrono::seconds>(time);
+  if (c->dateFormat != dateF || c->timeFormat != timeF) {
+    c->dateFormat = dateF;
+    c->timeFormat = timeF;
+    refreshTimestampCache(c, second);
+  } else if (c->second != second) {
+    refreshTimestampCache(c, second);
+  }
+
+  out->assign(c->prefix);
+  std::int64_t const nanoseconds =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(time - second)
+          .count();
+  for (auto const &[offset, digits] : c->fractions) {
+    std::int64_t value = nanoseconds / powersOfTen[9 - digits];
+    for (int i = digits; i--; value /= 10)
+      (*out)[offset + i] = char('0' + value % 10);
+  }
 }
 
 std::string logLevelToString(int const level) {
@@ -47,108 +149,251 @@ std::string logLevelToString(int const level) {
   }
 }
 
-EntryComponents makeEntryComponents(LoggerT *const l, std::string const &msg,
-                                    int const level) {
+EntryComponents
+makeEntryComponents(LoggerT *const l, ThreadState *const t,
+                    std::chrono::system_clock::time_point const time,
+                    std::string const &msg, int const level) {
   EntryComponents comps{};
-  comps.timestamp = getTimestamp(l->dateFormat, l->timeFormat);
+  getTimestamp(time, l->dateFormat, l->timeFormat, &comps.timestamp);
   comps.logLevel = logLevelToString(level);
-  comps.function = l->functions.back();
+  comps.function = currentScope(t);
   comps.message = msg;
   return comps;
 }
 
-std::string makeLogEntry(LoggerT *const l, EntryComponents const &comps) {
+std::string makeLogEntry(int const behavior, EntryComponents const &comps) {
   std::string entry{};
-  if ((l->oneTimeBehavior ? l->oneTimeBehavior : l->behavior) &
-      Behavior::PrefixTime)
+  if (behavior & Behavior::PrefixTime)
     entry += comps.timestamp + " ";
 
-  if ((l->oneTimeBehavior ? l->oneTimeBehavior : l->behavior) &
-      Behavior::PrefixLevel)
+  if (behavior & Behavior::PrefixLevel)
     entry += comps.logLevel + " ";
 
-  if ((l->oneTimeBehavior ? l->oneTimeBehavior : l->behavior) &
-      Behavior::PrefixFunc)
+  if (behavior & Behavior::PrefixFunc)
     entry += comps.function + ": ";
 
   entry += comps.message;
 
-  if ((l->oneTimeBehavior ? l->oneTimeBehavior : l->behavior) &
-      Behavior::AppendNewLine)
+  if (behavior & Behavior::AppendNewLine)
     entry += '\n';
   return entry;
 }
 
-void logToConsole(LoggerT *const l, std::string const &entry, int const level) {
-  auto const flush = [l](std::ostream &s, std::string const &entry) {
-    s << entry;
-    if ((l->oneTimeBehavior ? l->oneTimeBehavior : l->behavior) &
-        Behavior::FlushStream)
-      s << std::flush;
-  };
-
-  if ((l->oneTimeOutputMode ? l->oneTimeOutputMode : l->outputMode) &
-      OutputMode::Console) {
-    switch (level) {
-    case LogLevel::Error:
-      flush(std::cerr, entry);
-      break;
-    default:
-      flush(std::cout, entry);
-    }
-  }
+void logToConsole(std::string const &entry, int const level,
+                  int const behavior) {
+  auto &s = level == LogLevel::Error ? std::cerr : std::cout;
+  s << entry;
+  if (behavior & Behavior::FlushStream)
+    s << std::flush;
 }
 
-void logToBuffer(LoggerT *const l, EntryComponents const &comps,
-                 int const level) {
-  if ((l->oneTimeOutputMode ? l->oneTimeOutputMode : l->outputMode) &
-      OutputMode::Buffer) {
-    if (l->logBuffer.entries.size() == l->logBuffer.maxEntries)
-      l->logBuffer.entries.pop_front();
-    l->logBuffer.entries.push_back(
-        {std::move(comps), l->functions.size() - 1, level});
+namespace {
+// The entry is formatted before the sinks are locked, so that threads
+// only wait for each other to write it out.
+int writeEntry(LoggerT *const l, ThreadState *const t, std::string const &msg,
+               int const logLevel, int const outputMode, int const behavior) {
+  int result = Result::Success;
+
+  // The console and file outputs of an asynchronous logger are formatted
+  // and written by the writer thread, and the buffer keeps the parts of
+  // the entry unformatted.
+  int const writtenModes =
+      OutputMode::Console | OutputMode::File | OutputMode::RingFile;
+  int const syncModes =
+      l->logQueue ? OutputMode::Buffer : writtenModes | OutputMode::Buffer;
+  if (l->logQueue && (outputMode & writtenModes))
+    result = enqueueRecord(l, currentScope(t), msg, logLevel, outputMode,
+                           behavior);
+
+  if (outputMode & syncModes) {
+    auto const time = std::chrono::system_clock::now();
+    std::string entry{};
+    if (outputMode & syncModes & writtenModes)
+      entry = makeLogEntry(
+          behavior, makeEntryComponents(l, t, time, msg, logLevel));
+
+    std::lock_guard const lock{l->sinkMutex};
+    if (outputMode & syncModes & OutputMode::Console)
+      logToConsole(entry, logLevel, behavior);
+    if (outputMode & OutputMode::Buffer)
+      appendToTrace(&l->logBuffer, time, currentScope(t), msg, logLevel,
+                    t->depth.load(std::memory_order_relaxed));
+    if (outputMode & syncModes & OutputMode::File)
+      result = appendToFileSink(&l->fileSink, entry, logLevel);
+    if (outputMode & syncModes & OutputMode::RingFile)
+      if (int const r = appendToRingFile(&l->ringFile, entry);
+          r != Result::Success)
+        result = r;
   }
+  return result;
+}
+} // namespace
+
+bool isEntryEnabled(LoggerT *const l, int const logLevel) {
+  auto *const t = getThreadState(l);
+  return (t->oneTimeLogLevel ? t->oneTimeLogLevel : l->logLevel.load()) &
+         logLevel;
 }
 
-int log(LoggerT *const l, std::string const &msg, int logLevel) {
-  if (!((l->oneTimeLogLevel ? l->oneTimeLogLevel : l->logLevel) & logLevel))
+int log(LoggerT *const l, std::string const &msg, int const logLevel,
+        SuppressedEntries const &suppressed) {
+  auto *const t = getThreadState(l);
+  if (!((t->oneTimeLogLevel ? t->oneTimeLogLevel : l->logLevel.load()) &
+        logLevel))
     return Result::Success;
 
-  auto comps = makeEntryComponents(l, msg, logLevel);
-  auto entry = makeLogEntry(l, comps);
+  int const outputMode =
+      t->oneTimeOutputMode ? t->oneTimeOutputMode : l->outputMode.load();
+  int const behavior =
+      t->oneTimeBehavior ? t->oneTimeBehavior : l->behavior.load();
+  if (suppressed.folded)
+    writeEntry(l, t,
+               "last message repeated " + std::to_string(suppressed.folded) +
+                   " times",
+               logLevel, outputMode, behavior);
+  if (suppressed.rateLimited)
+    writeEntry(l, t,
+               std::to_string(suppressed.rateLimited) +
+                   " messages dropped by the rate limit",
+               logLevel, outputMode, behavior);
+  int const result = writeEntry(l, t, msg, logLevel, outputMode, behavior);
+  resetOneTimeProperties(t);
+  return result;
+}
+
+void resetOneTimeProperties(ThreadState *const t) {
+  t->oneTimePropertiesInitialized = false;
+  t->oneTimeOutputMode = false;
+  t->oneTimeLogLevel = false;
+  t->oneTimeBehavior = false;
+}
+
+namespace {
+constexpr std::size_t internCacheSize = 256;
+
+// A name interned by the thread, found again by the hash of its text.
+struct InternedName {
+  std::size_t hash{};
+  std::string_view name{};
+};
+
+thread_local std::array<InternedName, internCacheSize> internCache{};
+} // namespace
+
+/* The interned names are never freed, so that they outlive the threads
+ * still logging at exit, and the set grows with every distinct name for
+ * the life of the process. Every thread keeps the names it interned last
+ * in a direct-mapped cache, so that entering a scope of a name it already
+ * used takes no lock.
+ */
+char const *internScopeName(std::string_view const name) {
+  std::size_t const hash = std::hash<std::string_view>{}(name);
+  auto &cached = internCache[hash % internCacheSize];
+  if (cached.hash == hash && cached.name == name && cached.name.data())
+    return cached.name.data();
+
+  static std::mutex mutex{};
+  static auto *const names = new std::set<std::string, std::less<>>{};
+  std::lock_guard const lock{mutex};
+  auto it = names->find(name);
+  if (it == names->end())
+    it = names->emplace(name).first;
+  cached = {hash, *it};
+  return it->c_str();
+}
+
+namespace {
+// Only the owning thread changes the stack, so the sequence is odd while
+// it does.
+void beginScopeUpdate(ThreadState *const t) {
+  auto const sequence = t->scopeSequence.load(std::memory_order_relaxed);
+  t->scopeSequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+}
 
-  logToConsole(l, entry, logLevel);
-  logToBuffer(l, comps, logLevel);
+void endScopeUpdate(ThreadState *const t) {
+  auto const sequence = t->scopeSequence.load(std::memory_order_relaxed);
+  t->scopeSequence.store(sequence + 1, std::memory_order_release);
+}
+} // namespace
+
+ThreadState *stepIn(LoggerT *const l, char const *const name,
+                    bool *const profiled) {
+  auto *const t = getThreadState(l);
+  std::size_t const depth = t->depth.load(std::memory_order_relaxed) + 1;
+  beginScopeUpdate(t);
+  if (depth < maxScopeDepth)
+    t->scopes[depth].store(name, std::memory_order_relaxed);
+  t->depth.store(depth, std::memory_order_relaxed);
+  endScopeUpdate(t);
+  *profiled = l->profiling.load(std::memory_order_relaxed) &&
+              recordScopeEnter(l, t, name);
+  return t;
+}
 
-  if ((l->oneTimeOutputMode ? l->oneTimeOutputMode : l->outputMode) &
-      OutputMode::File) {
-    // TO BE DONE
+void stepOut(ThreadState *const t, bool const profiled) {
+  if (profiled)
+    recordScopeExit(t);
+  if (std::size_t const depth = t->depth.load(std::memory_order_relaxed)) {
+    beginScopeUpdate(t);
+    t->depth.store(depth - 1, std::memory_order_relaxed);
+    endScopeUpdate(t);
   }
+}
 
-  l->oneTimePropertiesInitialized = false;
-  l->oneTimeOutputMode = false;
-  l->oneTimeLogLevel = false;
-  l->oneTimeBehavior = false;
-  return Result::Success;
+ThreadState *copyPropertiesToOneTimeVariants(LoggerT *const l) {
+  auto *const t = getThreadState(l);
+  if (!t->oneTimePropertiesInitialized) {
+    t->oneTimeOutputMode = l->outputMode;
+    t->oneTimeBehavior = l->behavior;
+    t->oneTimeLogLevel = l->logLevel;
+  }
+  t->oneTimePropertiesInitialized = true;
+  return t;
 }
 
-int stepIn(LoggerT *const l, std::string const &func) {
-  l->functions.push_back(func);
-  return Result::Success;
+namespace {
+// The states of the loggers a thread used, with the last one looked up
+// kept aside. Logger ids are never reused, so the state of a destroyed
+// logger is never found again, and is freed when the thread exits.
+struct ThreadStates {
+  std::uint64_t lastId{};
+  ThreadState *last{};
+  std::vector<std::pair<std::uint64_t, std::shared_ptr<ThreadState>>> states{};
+};
+
+thread_local ThreadStates threadStates{};
+std::atomic<std::uint64_t> nextLoggerId{1};
+} // namespace
+
+std::uint64_t makeLoggerId() {
+  return nextLoggerId.fetch_add(1, std::memory_order_relaxed);
 }
 
-int stepOut(LoggerT *const l) {
-  if (l->functions.size())
-    l->functions.pop_back();
-  return Result::Success;
+ThreadState *getThreadState(LoggerT *const l) {
+  auto &ts = threadStates;
+  if (ts.lastId == l->id)
+    return ts.last;
+
+  auto it = std::find_if(ts.states.begin(), ts.states.end(),
+                         [l](auto const &s) { return s.first == l->id; });
+  if (it == ts.states.end()) {
+    auto state = std::make_shared<ThreadState>();
+    state->scopes[0] = l->name.c_str();
+    registerThreadState(l, state);
+    it = ts.states.emplace(ts.states.end(), l->id, std::move(state));
+  }
+  ts.lastId = l->id;
+  ts.last = it->second.get();
+  return ts.last;
 }
 
-void copyPropertiesToOneTimeVariants(LoggerT *const l) {
-  if (!l->oneTimePropertiesInitialized) {
-    l->oneTimeOutputMode = l->outputMode;
-    l->oneTimeBehavior = l->behavior;
-    l->oneTimeLogLevel = l->logLevel;
+void releaseThreadState(LoggerT *const l) {
+  auto &ts = threadStates;
+  std::erase_if(ts.states, [l](auto const &s) { return s.first == l->id; });
+  if (ts.lastId == l->id) {
+    ts.lastId = 0;
+    ts.last = nullptr;
   }
-  l->oneTimePropertiesInitialized = true;
 }
 } // namespace sl
@@ -20,22 +20,31 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
 #pragma once
 
+#include <badline/scopedLogger.hpp>
+#include <algorithm>
+#include <array>
+#include <memory>
 #include <string>
-#include <list>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <mutex>
 
 namespace sl {
 namespace OutputMode {
 constexpr int Console = 1 << 0;
 constexpr int File = 1 << 1;
 constexpr int Buffer = 1 << 2;
+constexpr int RingFile = 1 << 3;
+constexpr int BinaryFile = 1 << 4;
 } // namespace OutputMode
 
-namespace LogLevel {
-constexpr int Info = 1 << 0;
-constexpr int Warning = 1 << 1;
-constexpr int Error = 1 << 2;
-} // namespace LogLevel
-
 namespace Behavior {
 constexpr int AppendNewLine = 1 << 0;
 constexpr int FlushStream = 1 << 1;
@@ -51,42 +60,347 @@ struct EntryComponents {
   std::string message{};
 };
 
-struct LogEntry {
-  EntryComponents components{};
+// An entry of the trace, whose function name and message are kept one
+// after the other in the arena of the trace.
+struct TraceRecord {
+  std::chrono::system_clock::time_point time{};
+  std::size_t offset{};
+  std::uint32_t functionSize{};
+  std::uint32_t messageSize{};
   std::size_t depth{};
   int type{};
 };
 
+constexpr std::size_t traceBytesPerEntry = 128;
+constexpr std::size_t minTraceArenaSize = 1 << 16;
+
+/* A ring of records, and a ring of bytes holding their strings, both
+ * allocated on the first entry. The offsets count the bytes written
+ * since, and the strings of a record never wrap around the end of the
+ * arena, so the oldest records are dropped once either ring is full.
+ * The arena holds at least minTraceArenaSize bytes, and grows to take
+ * an entry larger than itself, in place of all the others.
+ */
 struct Buffer {
-  std::list<LogEntry> entries{};
+  std::vector<TraceRecord> records{};
+  std::size_t first{};
+  std::size_t count{};
+  std::vector<char> arena{};
+  std::size_t arenaHead{};
   std::size_t maxEntries{1000};
 };
 
-struct LoggerT {
-  int logLevel{LogLevel::Info | LogLevel::Warning | LogLevel::Error};
-  int outputMode{OutputMode::Console};
-  int behavior{Behavior::AppendNewLine | Behavior::FlushStream |
-               Behavior::PrefixTime | Behavior::PrefixLevel |
-               Behavior::PrefixFunc};
+// Entries are appended to a user-space buffer, which is written out
+// with a single write whenever the flush policy asks for it, or when
+// the next entry doesn't fit.
+struct FileSink {
+  int fd{-1};
+  std::string buffer{};
+  std::size_t capacity{1 << 16};
+  int flushPolicy{FlushPolicy::Bytes};
+  std::size_t flushThreshold{1 << 16};
+  bool sync{};
+  std::chrono::steady_clock::time_point lastFlush{};
+
+  FileSink() = default;
+  FileSink(FileSink const &) = delete;
+  FileSink &operator=(FileSink const &) = delete;
+  ~FileSink();
+};
+
+/* The header of a ring file, followed by the circular record area. Head
+ * is the write cursor and tail the position of the oldest record, both
+ * counted in bytes written since the file was created, so that the wrap
+ * count is the head divided by the capacity. A record is its length as
+ * a 32-bit word followed by the entry, padded to a multiple of four
+ * bytes, and never wraps around; a length of ringFilePadding marks the
+ * rest of the lap as unused.
+ */
+struct RingFileHeader {
+  char magic[8]{};
+  std::uint32_t version{};
+  std::uint32_t headerSize{};
+  std::uint64_t capacity{};
+  std::atomic<std::uint64_t> head{};
+  std::atomic<std::uint64_t> tail{};
+};
+
+constexpr char ringFileMagic[8] = {'B', 'L', 'S', 'L', 'R', 'I', 'N', 'G'};
+constexpr std::uint32_t ringFileVersion = 1;
+constexpr std::size_t ringFileHeaderSize = 64;
+constexpr std::uint32_t ringFilePadding = 0xFFFFFFFF;
+static_assert(sizeof(RingFileHeader) <= ringFileHeaderSize);
+
+// The positions of the header fields in the file, for the readers that
+// don't map it, as offsetof isn't portable for a struct with atomic members.
+constexpr std::size_t ringFileVersionOffset = 8;
+constexpr std::size_t ringFileHeaderSizeOffset = 12;
+constexpr std::size_t ringFileCapacityOffset = 16;
+constexpr std::size_t ringFileHeadOffset = 24;
+constexpr std::size_t ringFileTailOffset = 32;
+static_assert(sizeof(RingFileHeader) == ringFileTailOffset + 8 &&
+              alignof(RingFileHeader) == 8);
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+// Entries are copied straight into a shared mapping of the file, which
+// the kernel writes back even if the process dies.
+struct RingFile {
+  void *mapping{};
+  std::size_t mappingSize{};
+  RingFileHeader *header{};
+  char *data{};
+  std::size_t capacity{};
+
+  RingFile() = default;
+  RingFile(RingFile const &) = delete;
+  RingFile &operator=(RingFile const &) = delete;
+  ~RingFile();
+};
+
+// An entry of the written outputs, handed to the writer thread unformatted.
+struct AsyncRecord {
+  std::chrono::system_clock::time_point time{};
+  int logLevel{};
+  int outputMode{};
+  int behavior{};
+  char const *function{};
+  std::string message{};
+};
+
+/* A bounded multi-producer single-consumer queue, in which every cell
+ * carries a sequence number telling whether it is free for the producer
+ * claiming the position, or holds a record for the writer. The strings of
+ * a record keep their capacity once written out, so that a logger in
+ * a steady state copies messages into the queue without allocating.
+ * The writer advances written and fileFlushes under progressMutex, along
+ * with the result of the last flush, and wakes the threads waiting for
+ * them on progress.
+ */
+struct LogQueue {
+  struct Cell {
+    std::atomic<std::size_t> sequence{};
+    AsyncRecord record{};
+  };
+
+  std::unique_ptr<Cell[]> cells{};
+  std::size_t mask{};
+
+  alignas(64) std::atomic<std::size_t> enqueuePos{};
+  alignas(64) std::atomic<std::size_t> dequeuePos{};
+  std::atomic<std::size_t> peakOccupancy{};
+  std::atomic<std::size_t> dropped{};
+  std::atomic<std::size_t> written{};
+  std::atomic<std::size_t> fileFlushRequests{};
+  std::atomic<std::size_t> fileFlushes{};
+  int fileFlushResult{Result::Success};
+  std::mutex progressMutex{};
+  std::condition_variable progress{};
+
+  std::atomic<bool> stop{};
+  std::thread writer{};
+
+  ~LogQueue();
+};
+
+// A scope entered, or left when the name is null, in nanoseconds of the
+// steady clock.
+struct ScopeEvent {
+  std::int64_t time{};
+  char const *name{};
+};
+
+/* The scope events of one thread, in a buffer allocated once. The thread
+ * publishes an event by the release store of the size covering it, so
+ * that the profile may be read while it runs. An enter is only recorded
+ * if the exits of the open scopes still fit after it.
+ */
+struct ProfileBuffer {
+  std::unique_ptr<ScopeEvent[]> events{};
+  std::size_t capacity{};
+  std::atomic<std::size_t> size{};
+  std::atomic<std::size_t> dropped{};
+  std::size_t thread{};
+};
+
+constexpr std::size_t maxScopeDepth = 256;
+
+// The id a binary log file gave the scope of a stack entry.
+struct BinaryScopeId {
+  char const *scope{};
+  std::uint64_t generation{};
+  std::uint32_t id{};
+};
+
+/* The state every thread keeps for a logger it uses: its own scope stack,
+ * rooted at the name of the logger, and the properties of its next entry.
+ * The stack holds the names of the scopes by address, and depth counts the
+ * scopes entered; those past its capacity log under the deepest one kept.
+ * The thread makes the sequence odd while it changes the stack, so that
+ * the sampling thread may copy the stack, and retry if the sequence
+ * changed in the meantime. Every entry of the stack also keeps the id the
+ * binary log file gave its scope, used under the sink mutex.
+ */
+struct ThreadState {
+  std::array<std::atomic<char const *>, maxScopeDepth> scopes{};
+  std::atomic<std::size_t> depth{};
+  std::atomic<std::uint32_t> scopeSequence{};
+  std::array<BinaryScopeId, maxScopeDepth> binaryScopeIds{};
+
+  std::shared_ptr<ProfileBuffer> profile{};
+  std::uint64_t profileGeneration{};
+  std::size_t openProfiledScopes{};
 
   int oneTimeLogLevel{0}, oneTimeOutputMode{0}, oneTimeBehavior{0};
   bool oneTimePropertiesInitialized{false};
+};
+
+// The sampling thread, and the stacks it found, counted by their scopes.
+struct ScopeSampler {
+  std::atomic<bool> stop{};
+  std::thread thread{};
+
+  std::mutex mutex{};
+  std::map<std::vector<std::string>, std::size_t> stacks{};
+  std::size_t samples{};
+  std::size_t idleSamples{};
+  std::size_t missedSamples{};
+
+  ~ScopeSampler();
+};
 
-  std::list<std::string> functions{};
+/* The properties may be toggled while other threads log, and the sinks
+ * are shared behind sinkMutex, which is held only to write an entry that
+ * was already formatted. The formats, the files and the asynchronous mode
+ * are set up while no other thread logs.
+ */
+struct LoggerT {
+  std::uint64_t id{};
+  std::string name{};
+
+  std::atomic<int> logLevel{LogLevel::Info | LogLevel::Warning |
+                            LogLevel::Error};
+  std::atomic<int> outputMode{OutputMode::Console};
+  std::atomic<int> behavior{Behavior::AppendNewLine | Behavior::FlushStream |
+                            Behavior::PrefixTime | Behavior::PrefixLevel |
+                            Behavior::PrefixFunc};
+
+  std::mutex sinkMutex{};
 
   std::string dateFormat{"%Y/%m/%d"};
   std::string timeFormat{"%H:%M:%S"};
 
   std::string logFile{};
+  FileSink fileSink{};
+  RingFile ringFile{};
+  FileSink binarySink{};
+  std::vector<bool> definedCallSites{};
+  std::unordered_map<char const *, std::uint32_t> definedScopes{};
+  std::uint64_t binaryLogGeneration{};
   Buffer logBuffer{};
+
+  std::atomic<bool> profiling{};
+  std::atomic<std::uint64_t> profileGeneration{};
+  std::mutex profileMutex{};
+  std::size_t profileBufferSize{1 << 16};
+  std::vector<std::shared_ptr<ProfileBuffer>> profileBuffers{};
+
+  std::mutex threadsMutex{};
+  std::vector<std::shared_ptr<ThreadState>> threads{};
+  std::atomic<std::size_t> sampleRate{1000};
+
+  std::atomic<std::int64_t> rateLimitIntervalNs{};
+  std::atomic<std::int64_t> rateLimitBurst{};
+  std::atomic<bool> foldDuplicates{};
+  std::atomic<std::size_t> rateLimitedEntries{};
+  std::atomic<std::size_t> foldedEntries{};
+
+  std::size_t logQueueSize{1024};
+  std::unique_ptr<LogQueue> logQueue{};
+
+  // Destroyed first, as the sampling thread reads the thread states.
+  std::unique_ptr<ScopeSampler> sampler{};
 };
 
-int stepIn(LoggerT *const, std::string const &func);
-int stepOut(LoggerT *const);
-int log(LoggerT *const l, std::string const &msg, int const logLevel);
-void copyPropertiesToOneTimeVariants(LoggerT *const l);
+ThreadState *getThreadState(LoggerT *const l);
+void releaseThreadState(LoggerT *const l);
+void registerThreadState(LoggerT *const l,
+                         std::shared_ptr<ThreadState> const &state);
+std::uint64_t makeLoggerId();
+
+inline char const *currentScope(ThreadState const *const t) {
+  std::size_t const depth = t->depth.load(std::memory_order_relaxed);
+  return t->scopes[std::min(depth, maxScopeDepth - 1)].load(
+      std::memory_order_relaxed);
+}
+
+char const *internScopeName(std::string_view const name);
+ThreadState *stepIn(LoggerT *const, char const *const name,
+                    bool *const profiled);
+void stepOut(ThreadState *const, bool const profiled);
+bool recordScopeEnter(LoggerT *const l, ThreadState *const t,
+                      char const *const name);
+void recordScopeExit(ThreadState *const t);
+
+// The entries a call site suppressed since the last one it wrote.
+struct SuppressedEntries {
+  std::uint32_t folded{};
+  std::uint32_t rateLimited{};
+};
+
+bool isEntryEnabled(LoggerT *const l, int const logLevel);
+void resetOneTimeProperties(ThreadState *const t);
+int log(LoggerT *const l, std::string const &msg, int const logLevel,
+        SuppressedEntries const &suppressed = {});
+
+bool isSuppressionEnabled(LoggerT *const l);
+bool suppressEntry(LoggerT *const l, detail::SiteLimiter *const site,
+                   std::string_view const entry,
+                   SuppressedEntries *const suppressed);
+int logAtLocation(LoggerT *const l, std::string const &msg, int const logLevel,
+                  std::source_location const &location);
+ThreadState *copyPropertiesToOneTimeVariants(LoggerT *const l);
 
-std::string makeLogEntry(LoggerT *const l, std::string const &msg, int const lv);
+std::string makeLogEntry(int const behavior, EntryComponents const &comps);
 std::string logLevelToString(int const level);
 std::string getTimestamp(std::string const &dateF, std::string const &timeF);
+std::string getTimestamp(std::chrono::system_clock::time_point const time,
+                         std::string const &dateF, std::string const &timeF);
+void getTimestamp(std::chrono::system_clock::time_point const time,
+                  std::string const &dateF, std::string const &timeF,
+                  std::string *const out);
+
+int startLogQueue(LoggerT *const l);
+int enqueueRecord(LoggerT *const l, char const *const function,
+                  std::string const &msg, int const level,
+                  int const outputMode, int const behavior);
+
+// The writer thread reads the configuration of the logger and owns its
+// sinks while it runs, so it is stopped for the time they change.
+template <typename F> int pauseWriter(LoggerT *const l, F const &fn) {
+  bool const async = bool(l->logQueue);
+  l->logQueue.reset();
+  int const r = fn();
+  if (async)
+    startLogQueue(l);
+  return r;
+}
+
+int openFileSink(FileSink *const sink, std::string const &path);
+int appendToFileSink(FileSink *const sink, std::string_view const entry,
+                     int const level);
+int flushFileSink(FileSink *const sink);
+int flushFileSinkIfDue(FileSink *const sink);
+
+int openRingFile(RingFile *const ring, std::string const &path,
+                 std::size_t const size);
+int appendToRingFile(RingFile *const ring, std::string_view entry);
+
+void appendToTrace(Buffer *const b,
+                   std::chrono::system_clock::time_point const time,
+                   std::string_view function, std::string_view message,
+                   int const level, std::size_t const depth);
+int resizeTrace(Buffer *const b, std::size_t const size);
+
+std::string formatPacked(std::string_view const format, char const *const args,
+                         std::size_t const size);
 } // namespace sl
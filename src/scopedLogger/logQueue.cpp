@@ -0,0 +1,256 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <badline/scopedLogger.hpp>
+#include "internals.hpp"
+#include <iostream>
+
+namespace sl {
+namespace {
+constexpr std::size_t writerBatchSize = 256;
+constexpr std::chrono::milliseconds writerIdleSleep{1};
+constexpr std::size_t reservedMessageLength = 128;
+
+bool dequeueRecord(LogQueue *const q, AsyncRecord **const record) {
+  std::size_t const pos = q->dequeuePos.load(std::memory_order_relaxed);
+  auto &cell = q->cells[pos & q->mask];
+  if (cell.sequence.load(std::memory_order_acquire) != pos + 1)
+    return false;
+  *record = &cell.record;
+  return true;
+}
+
+void releaseRecord(LogQueue *const q) {
+  std::size_t const pos = q->dequeuePos.load(std::memory_order_relaxed);
+  q->cells[pos & q->mask].sequence.store(pos + q->mask + 1,
+                                         std::memory_order_release);
+  q->dequeuePos.store(pos + 1, std::memory_order_release);
+}
+
+// Updates a counter under the mutex the waiting threads check it with, so
+// that none of them misses the notification.
+template <typename F> void advance(LogQueue *const q, F const &update) {
+  {
+    std::lock_guard const lock{q->progressMutex};
+    update();
+  }
+  q->progress.notify_all();
+}
+
+// Formats the records in batches, one write per stream and batch, and
+// flushes a stream once per batch if any of its records asked for it.
+// The file entries go through the file sink and its flush policy, and
+// the ring file entries are copied into its mapping.
+void runWriter(LoggerT *const l, LogQueue *const q) {
+  std::string out{}, err{};
+  EntryComponents comps{};
+
+  while (true) {
+    bool flushOut{}, flushErr{};
+    std::size_t count = 0;
+    AsyncRecord *record{};
+
+    for (; count < writerBatchSize && dequeueRecord(q, &record); ++count) {
+      getTimestamp(record->time, l->dateFormat, l->timeFormat,
+                   &comps.timestamp);
+      comps.logLevel = logLevelToString(record->logLevel);
+      comps.function = record->function;
+      comps.message = record->message;
+      auto const entry = makeLogEntry(record->behavior, comps);
+
+      if (record->outputMode & OutputMode::Console) {
+        bool const isError = record->logLevel == LogLevel::Error;
+        bool const flush = record->behavior & Behavior::FlushStream;
+        (isError ? err : out) += entry;
+        (isError ? flushErr : flushOut) |= flush;
+      }
+      if (record->outputMode & OutputMode::File)
+        appendToFileSink(&l->fileSink, entry, record->logLevel);
+      if (record->outputMode & OutputMode::RingFile)
+        appendToRingFile(&l->ringFile, entry);
+      releaseRecord(q);
+    }
+
+    if (out.size()) {
+      std::cout.write(out.data(), out.size());
+      out.clear();
+    }
+    if (flushOut)
+      std::cout.flush();
+    if (err.size()) {
+      std::cerr.write(err.data(), err.size());
+      err.clear();
+    }
+    if (flushErr)
+      std::cerr.flush();
+
+    if (count)
+      advance(q, [q, count] {
+        q->written.fetch_add(count, std::memory_order_release);
+      });
+    if (std::size_t const requests = q->fileFlushRequests.load();
+        requests != q->fileFlushes.load(std::memory_order_relaxed)) {
+      int const r = flushFileSink(&l->fileSink);
+      advance(q, [q, requests, r] {
+        q->fileFlushResult = r;
+        q->fileFlushes.store(requests, std::memory_order_release);
+      });
+    }
+
+    if (count)
+      continue;
+    if (q->stop.load(std::memory_order_acquire))
+      break;
+    flushFileSinkIfDue(&l->fileSink);
+    std::this_thread::sleep_for(writerIdleSleep);
+  }
+}
+
+std::size_t roundUpToPowerOfTwo(std::size_t const size) {
+  std::size_t capacity = 1;
+  while (capacity < size)
+    capacity <<= 1;
+  return capacity;
+}
+} // namespace
+
+LogQueue::~LogQueue() {
+  stop.store(true, std::memory_order_release);
+  if (writer.joinable())
+    writer.join();
+}
+
+int startLogQueue(LoggerT *const l) {
+  auto q = std::make_unique<LogQueue>();
+  std::size_t const capacity = roundUpToPowerOfTwo(l->logQueueSize);
+  q->cells = std::make_unique<LogQueue::Cell[]>(capacity);
+  q->mask = capacity - 1;
+  for (std::size_t i = 0; i < capacity; ++i) {
+    q->cells[i].sequence.store(i, std::memory_order_relaxed);
+    q->cells[i].record.message.reserve(reservedMessageLength);
+  }
+
+  q->writer = std::thread{runWriter, l, q.get()};
+  l->logQueue = std::move(q);
+  return Result::Success;
+}
+
+int enqueueRecord(LoggerT *const l, char const *const function,
+                  std::string const &msg, int const level,
+                  int const outputMode, int const behavior) {
+  auto *const q = l->logQueue.get();
+  std::size_t pos = q->enqueuePos.load(std::memory_order_relaxed);
+  LogQueue::Cell *cell{};
+
+  while (true) {
+    cell = &q->cells[pos & q->mask];
+    std::size_t const sequence = cell->sequence.load(std::memory_order_acquire);
+    auto const diff = std::ptrdiff_t(sequence) - std::ptrdiff_t(pos);
+    if (diff == 0 && q->enqueuePos.compare_exchange_weak(
+                         pos, pos + 1, std::memory_order_relaxed))
+      break;
+    if (diff < 0) {
+      q->dropped.fetch_add(1, std::memory_order_relaxed);
+      return Result::ErrorLogQueueFull;
+    }
+    if (diff > 0)
+      pos = q->enqueuePos.load(std::memory_order_relaxed);
+  }
+
+  auto &record = cell->record;
+  record.time = std::chrono::system_clock::now();
+  record.logLevel = level;
+  record.outputMode = outputMode;
+  record.behavior = behavior;
+  record.function = function;
+  record.message = msg;
+  cell->sequence.store(pos + 1, std::memory_order_release);
+
+  std::size_t const occupancy =
+      pos + 1 - q->dequeuePos.load(std::memory_order_relaxed);
+  std::size_t peak = q->peakOccupancy.load(std::memory_order_relaxed);
+  while (occupancy > peak && !q->peakOccupancy.compare_exchange_weak(
+                                 peak, occupancy, std::memory_order_relaxed))
+    ;
+  return Result::Success;
+}
+
+int writeAsync(LoggerT *const l, bool const v) {
+  if (!l)
+    return Result::ErrorNullptrParameter;
+  if (v == bool(l->logQueue))
+    return Result::Success;
+  if (v)
+    return startLogQueue(l);
+
+  l->logQueue.reset();
+  return Result::Success;
+}
+
+int resizeLogQueue(LoggerT *const l, std::size_t const size) {
+  if (!l)
+    return Result::ErrorNullptrParameter;
+  if (!size)
+    return Result::ErrorLogQueueSizeNotValid;
+
+  l->logQueueSize = size;
+  if (!l->logQueue)
+    return Result::Success;
+
+  // The pending records are written out by the old writer first.
+  l->logQueue.reset();
+  return startLogQueue(l);
+}
+
+int flushLogQueue(LoggerT *const l) {
+  if (!l)
+    return Result::ErrorNullptrParameter;
+  if (!l->logQueue)
+    return Result::Success;
+
+  auto *const q = l->logQueue.get();
+  std::size_t const target = q->enqueuePos.load(std::memory_order_acquire);
+  std::unique_lock lock{q->progressMutex};
+  q->progress.wait(lock, [q, target] {
+    return q->written.load(std::memory_order_acquire) >= target;
+  });
+  return Result::Success;
+}
+
+int getLogQueueStats(LoggerT *const l, LogQueueStats *const stats) {
+  if (!l || !stats)
+    return Result::ErrorNullptrParameter;
+
+  *stats = {};
+  stats->capacity = l->logQueue ? l->logQueue->mask + 1
+                                : roundUpToPowerOfTwo(l->logQueueSize);
+  if (!l->logQueue)
+    return Result::Success;
+
+  auto *const q = l->logQueue.get();
+  std::size_t const enqueued = q->enqueuePos.load(std::memory_order_acquire);
+  stats->enqueued = enqueued;
+  stats->occupancy = enqueued - q->dequeuePos.load(std::memory_order_acquire);
+  stats->peakOccupancy = q->peakOccupancy.load(std::memory_order_relaxed);
+  stats->dropped = q->dropped.load(std::memory_order_relaxed);
+  stats->written = q->written.load(std::memory_order_acquire);
+  return Result::Success;
+}
+} // namespace sl
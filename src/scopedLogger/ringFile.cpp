@@ -0,0 +1,223 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <badline/scopedLogger.hpp>
+#include "internals.hpp"
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sl {
+namespace {
+constexpr std::size_t lengthSize = sizeof(std::uint32_t);
+
+std::size_t recordSize(std::size_t const length) {
+  return (lengthSize + length + 3) & ~std::size_t{3};
+}
+
+// Returns the position of the record following the one at pos, skipping
+// the padding at the end of a lap.
+std::uint64_t nextRecord(char const *const data, std::size_t const capacity,
+                         std::uint64_t const pos) {
+  std::size_t const offset = pos % capacity;
+  std::uint32_t length{};
+  std::memcpy(&length, data + offset, lengthSize);
+  if (length == ringFilePadding)
+    return pos + capacity - offset;
+  return pos + recordSize(length);
+}
+
+// Walks the records from the tail to the head, each of which has to end
+// within its lap and before the head, and collects their entries.
+bool walkRecords(char const *const data, std::size_t const capacity,
+                 std::uint64_t const tail, std::uint64_t const head,
+                 std::vector<std::string> *const entries) {
+  for (std::uint64_t pos = tail; pos < head;) {
+    std::size_t const offset = pos % capacity;
+    std::uint32_t length{};
+    std::memcpy(&length, data + offset, lengthSize);
+    std::uint64_t const next = nextRecord(data, capacity, pos);
+    if (next > head || next - pos > capacity - offset)
+      return false;
+    if (entries && length != ringFilePadding)
+      entries->emplace_back(data + offset + lengthSize, length);
+    pos = next;
+  }
+  return true;
+}
+
+// A reused file is only appended to if its records can be walked, as the
+// tail is moved along them to make room.
+bool isHeaderValid(RingFileHeader const *const h, char const *const data,
+                   std::size_t const capacity) {
+  std::uint64_t const head = h->head.load(std::memory_order_acquire);
+  std::uint64_t const tail = h->tail.load(std::memory_order_acquire);
+  return !std::memcmp(h->magic, ringFileMagic, sizeof(ringFileMagic)) &&
+         h->version == ringFileVersion &&
+         h->headerSize == ringFileHeaderSize && h->capacity == capacity &&
+         tail <= head && head - tail <= capacity && !(head % 4) &&
+         !(tail % 4) && walkRecords(data, capacity, tail, head, nullptr);
+}
+
+template <typename T>
+T readField(std::string const &file, std::size_t const offset) {
+  T value{};
+  std::memcpy(&value, file.data() + offset, sizeof(T));
+  return value;
+}
+} // namespace
+
+RingFile::~RingFile() {
+  if (mapping)
+    ::munmap(mapping, mappingSize);
+}
+
+int openRingFile(RingFile *const ring, std::string const &path,
+                 std::size_t const size) {
+  std::size_t const capacity = size & ~std::size_t{3};
+  std::size_t const mappingSize = ringFileHeaderSize + capacity;
+  int const fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (fd < 0)
+    return Result::ErrorFileAccessFailure;
+
+  // The blocks are allocated up front, so that a full disk fails here
+  // instead of raising SIGBUS when a page is first written.
+  struct stat st{};
+  bool const reuse =
+      !::fstat(fd, &st) && std::size_t(st.st_size) == mappingSize;
+  if (!reuse && (::ftruncate(fd, 0) || ::posix_fallocate(fd, 0, mappingSize))) {
+    ::close(fd);
+    return Result::ErrorFileAccessFailure;
+  }
+
+  void *const mapping =
+      ::mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED)
+    return Result::ErrorFileAccessFailure;
+
+  auto *header = static_cast<RingFileHeader *>(mapping);
+  char *const data = static_cast<char *>(mapping) + ringFileHeaderSize;
+  if (!reuse || !isHeaderValid(header, data, capacity)) {
+    header = new (mapping) RingFileHeader{};
+    header->version = ringFileVersion;
+    header->headerSize = ringFileHeaderSize;
+    header->capacity = capacity;
+    std::memcpy(header->magic, ringFileMagic, sizeof(ringFileMagic));
+  }
+
+  if (ring->mapping)
+    ::munmap(ring->mapping, ring->mappingSize);
+  ring->mapping = mapping;
+  ring->mappingSize = mappingSize;
+  ring->header = header;
+  ring->data = data;
+  ring->capacity = capacity;
+  return Result::Success;
+}
+
+// The tail is moved past the records about to be overwritten before the
+// entry is copied, and the head past the entry after that, so that
+// a crash at any point leaves the records between them intact.
+int appendToRingFile(RingFile *const ring, std::string_view entry) {
+  if (!ring->header)
+    return Result::ErrorFileAccessFailure;
+
+  std::size_t const capacity = ring->capacity;
+  entry = entry.substr(0, capacity - lengthSize);
+  auto *const h = ring->header;
+  std::uint64_t const head = h->head.load(std::memory_order_relaxed);
+  std::uint64_t tail = h->tail.load(std::memory_order_relaxed);
+
+  std::size_t const size = recordSize(entry.size());
+  std::size_t const offset = head % capacity;
+  std::uint64_t const start =
+      capacity - offset < size ? head + capacity - offset : head;
+  while (tail < head && start + size - tail > capacity)
+    tail = nextRecord(ring->data, capacity, tail);
+  // An entry skipping to the next lap may need the room of every record,
+  // and the bytes past the head are stale.
+  if (start + size - tail > capacity)
+    tail = start;
+  h->tail.store(tail, std::memory_order_release);
+
+  if (start != head)
+    std::memcpy(ring->data + offset, &ringFilePadding, lengthSize);
+  auto const length = std::uint32_t(entry.size());
+  char *const record = ring->data + start % capacity;
+  std::memcpy(record, &length, lengthSize);
+  std::memcpy(record + lengthSize, entry.data(), entry.size());
+  h->head.store(start + size, std::memory_order_release);
+  return Result::Success;
+}
+
+int setRingLogFile(LoggerT *const l, std::string const &path,
+                   std::size_t const size) {
+  if (!l)
+    return Result::ErrorNullptrParameter;
+  if (size < 2 * recordSize(0))
+    return Result::ErrorLogBufferSizeNotValid;
+
+  return pauseWriter(
+      l, [l, &path, size] { return openRingFile(&l->ringFile, path, size); });
+}
+
+int readRingLogFile(std::string const &path,
+                    std::vector<std::string> *const entries,
+                    std::size_t *const wraps) {
+  if (!entries)
+    return Result::ErrorNullptrParameter;
+
+  std::ifstream stream{path, std::ios::binary};
+  if (!stream)
+    return Result::ErrorFileAccessFailure;
+  std::string const file{std::istreambuf_iterator<char>{stream}, {}};
+  std::size_t const capacity = file.size() - ringFileHeaderSize;
+  if (file.size() < ringFileHeaderSize + 2 * recordSize(0) || capacity % 4 ||
+      file.compare(0, sizeof(ringFileMagic), ringFileMagic,
+                   sizeof(ringFileMagic)))
+    return Result::ErrorRingFileNotValid;
+
+  auto const head = readField<std::uint64_t>(file, ringFileHeadOffset);
+  auto const tail = readField<std::uint64_t>(file, ringFileTailOffset);
+  if (readField<std::uint32_t>(file, ringFileVersionOffset) !=
+          ringFileVersion ||
+      readField<std::uint32_t>(file, ringFileHeaderSizeOffset) !=
+          ringFileHeaderSize ||
+      readField<std::uint64_t>(file, ringFileCapacityOffset) != capacity ||
+      tail > head || head - tail > capacity || head % 4 || tail % 4)
+    return Result::ErrorRingFileNotValid;
+
+  char const *const data = file.data() + ringFileHeaderSize;
+  std::vector<std::string> result{};
+  if (!walkRecords(data, capacity, tail, head, &result))
+    return Result::ErrorRingFileNotValid;
+
+  *entries = std::move(result);
+  if (wraps)
+    *wraps = head / capacity;
+  return Result::Success;
+}
+} // namespace sl
@@ -0,0 +1,253 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <badline/scopedLogger.hpp>
+#include "internals.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <unistd.h>
+
+namespace sl {
+namespace {
+std::int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void appendScopeEvent(ProfileBuffer *const b, char const *const name) {
+  std::size_t const size = b->size.load(std::memory_order_relaxed);
+  b->events[size] = {nowNs(), name};
+  b->size.store(size + 1, std::memory_order_release);
+}
+
+struct Frame {
+  char const *name{};
+  std::int64_t begin{};
+  std::int64_t children{};
+  std::size_t pathSize{};
+};
+
+/* Replays the events of every thread, handing every scope over with its
+ * thread, its path in the call tree, its bounds, and the time spent in
+ * the scopes it entered. The scopes still open are closed at the time of
+ * the replay, and the exits left without an enter, by a profile cleared
+ * while their scopes were open, are skipped. Returns the thread count.
+ */
+template <typename F>
+std::size_t replayProfile(LoggerT *const l, std::size_t *const dropped,
+                          F const &onScope) {
+  std::vector<std::shared_ptr<ProfileBuffer>> buffers{};
+  {
+    std::lock_guard const lock{l->profileMutex};
+    buffers = l->profileBuffers;
+  }
+
+  std::int64_t const now = nowNs();
+  std::string path{};
+  std::vector<Frame> frames{};
+  for (auto const &b : buffers) {
+    *dropped += b->dropped.load(std::memory_order_relaxed);
+    path = l->name;
+    auto const close = [&](std::int64_t const end) {
+      Frame const f = frames.back();
+      frames.pop_back();
+      onScope(b->thread, path, f.name, f.begin, end, f.children);
+      path.resize(f.pathSize);
+      if (!frames.empty())
+        frames.back().children += end - f.begin;
+    };
+
+    std::size_t const size = b->size.load(std::memory_order_acquire);
+    for (std::size_t i = 0; i < size; ++i) {
+      auto const &e = b->events[i];
+      if (e.name) {
+        frames.push_back({e.name, e.time, 0, path.size()});
+        (path += ';') += e.name;
+      } else if (!frames.empty()) {
+        close(e.time);
+      }
+    }
+    while (!frames.empty())
+      close(now);
+  }
+  return buffers.size();
+}
+
+void writeJsonString(std::ostream &s, std::string_view const v) {
+  s << '"';
+  for (char const c : v) {
+    if (c == '"' || c == '\\')
+      s << '\\' << c;
+    else if (static_cast<unsigned char>(c) < 0x20)
+      s << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c)
+        << std::dec;
+    else
+      s << c;
+  }
+  s << '"';
+}
+} // namespace
+
+bool recordScopeEnter(LoggerT *const l, ThreadState *const t,
+                      char const *const name) {
+  if (!t->profile || t->profileGeneration !=
+                         l->profileGeneration.load(std::memory_order_acquire)) {
+    auto b = std::make_shared<ProfileBuffer>();
+    std::lock_guard const lock{l->profileMutex};
+    b->capacity = l->profileBufferSize;
+    b->events = std::make_unique<ScopeEvent[]>(b->capacity);
+    b->thread = l->profileBuffers.size();
+    l->profileBuffers.push_back(b);
+    t->profile = std::move(b);
+    t->profileGeneration = l->profileGeneration.load();
+    t->openProfiledScopes = 0;
+  }
+
+  auto *const b = t->profile.get();
+  if (b->size.load(std::memory_order_relaxed) + t->openProfiledScopes + 2 >
+      b->capacity) {
+    b->dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  appendScopeEvent(b, name);
+  ++t->openProfiledScopes;
+  return true;
+}
+
+void recordScopeExit(ThreadState *const t) {
+  if (!t->openProfiledScopes)
+    return;
+  --t->openProfiledScopes;
+  appendScopeEvent(t->profile.get(), nullptr);
+}
+
+int profileScopes(LoggerT *const l, bool const v) {
+  if (!l)
+    return Result::ErrorNullptrParameter;
+  l->profiling.store(v, std::memory_order_relaxed);
+  return Result::Success;
+}
+
+int resizeProfileBuffer(LoggerT *const l, std::size_t const events) {
+  if (!l)
+    return Result::ErrorNullptrParameter;
+  if (events < 2)
+    return Result::ErrorProfileBufferSizeNotValid;
+
+  std::lock_guard const lock{l->profileMutex};
+  l->profileBufferSize = events;
+  l->profileBuffers.clear();
+  l->profileGeneration.fetch_add(1, std::memory_order_release);
+  return Result::Success;
+}
+
+int getScopeProfile(LoggerT *const l, ScopeProfile *const profile) {
+  if (!l || !profile)
+    return Result::ErrorNullptrParameter;
+
+  std::map<std::string, ScopeProfileEntry> entries{};
+  std::size_t dropped{};
+  profile->threads = replayProfile(
+      l, &dropped,
+      [&](std::size_t, std::string const &path, char const *,
+          std::int64_t const begin, std::int64_t const end,
+          std::int64_t const children) {
+        auto &e = entries[path];
+        ++e.calls;
+        e.inclusiveNs += end - begin;
+        e.exclusiveNs += end - begin - children;
+      });
+
+  profile->droppedScopes = dropped;
+  profile->entries.clear();
+  for (auto &[path, e] : entries) {
+    e.path = path;
+    profile->entries.push_back(std::move(e));
+  }
+  return Result::Success;
+}
+
+int writeChromeTrace(LoggerT *const l, std::string const &path) {
+  if (!l)
+    return Result::ErrorNullptrParameter;
+
+  struct Span {
+    std::size_t thread{};
+    char const *name{};
+    std::int64_t begin{}, end{};
+  };
+  std::vector<Span> spans{};
+  std::size_t dropped{};
+  std::size_t const threads = replayProfile(
+      l, &dropped,
+      [&](std::size_t const thread, std::string const &, char const *name,
+          std::int64_t const begin, std::int64_t const end, std::int64_t) {
+        spans.push_back({thread, name, begin, end});
+      });
+
+  std::ofstream file{path, std::ios::trunc};
+  if (!file)
+    return Result::ErrorFileAccessFailure;
+
+  // The timestamps are in microseconds since the first scope.
+  std::int64_t origin = spans.empty() ? 0 : spans.front().begin;
+  for (auto const &s : spans)
+    origin = std::min(origin, s.begin);
+  int const pid = ::getpid();
+
+  file << std::fixed << std::setprecision(3);
+  file << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n";
+  for (std::size_t t = 0; t < threads; ++t) {
+    file << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " << pid
+         << ", \"tid\": " << t << ", \"args\": {\"name\": ";
+    writeJsonString(file, l->name + " thread " + std::to_string(t));
+    file << "}}" << (t + 1 == threads && spans.empty() ? "\n" : ",\n");
+  }
+  for (std::size_t i = 0; i < spans.size(); ++i) {
+    auto const &s = spans[i];
+    file << "{\"name\": ";
+    writeJsonString(file, s.name);
+    file << ", \"cat\": \"scope\", \"ph\": \"X\", \"pid\": " << pid
+         << ", \"tid\": " << s.thread
+         << ", \"ts\": " << double(s.begin - origin) / 1000
+         << ", \"dur\": " << double(s.end - s.begin) / 1000 << "}"
+         << (i + 1 == spans.size() ? "\n" : ",\n");
+  }
+  file << "]}\n";
+  return file ? Result::Success : Result::ErrorFileAccessFailure;
+}
+
+int writeCollapsedStacks(LoggerT *const l, std::string const &path) {
+  ScopeProfile profile{};
+  if (int const r = getScopeProfile(l, &profile); r != Result::Success)
+    return r;
+
+  std::ofstream file{path, std::ios::trunc};
+  if (!file)
+    return Result::ErrorFileAccessFailure;
+  for (auto const &e : profile.entries)
+    if (e.exclusiveNs)
+      file << e.path << " " << e.exclusiveNs << "\n";
+  return file ? Result::Success : Result::ErrorFileAccessFailure;
+}
+} // namespace sl
@@ -0,0 +1,201 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <badline/scopedLogger.hpp>
+#include "internals.hpp"
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace sl {
+namespace {
+constexpr int maxSnapshotAttempts = 16;
+
+/* Copies the scope stack of a thread, retrying while the thread changes
+ * it, which it marks with an odd sequence. Returns false if the stack kept
+ * changing.
+ */
+bool snapshotScopes(ThreadState const *const t,
+                    std::vector<char const *> *const scopes) {
+  for (int attempt = 0; attempt < maxSnapshotAttempts; ++attempt) {
+    auto const before = t->scopeSequence.load(std::memory_order_acquire);
+    if (before & 1)
+      continue;
+    std::size_t const depth = std::min(
+        t->depth.load(std::memory_order_relaxed), maxScopeDepth - 1);
+    scopes->resize(depth + 1);
+    for (std::size_t i = 0; i <= depth; ++i)
+      (*scopes)[i] = t->scopes[i].load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (t->scopeSequence.load(std::memory_order_relaxed) == before)
+      return true;
+  }
+  return false;
+}
+
+void sampleThreads(LoggerT *const l, ScopeSampler *const s,
+                   std::vector<char const *> *const scopes) {
+  // The states only held by the logger belong to exited threads.
+  std::vector<std::shared_ptr<ThreadState>> threads{};
+  {
+    std::lock_guard const lock{l->threadsMutex};
+    for (auto const &t : l->threads)
+      if (t.use_count() > 1)
+        threads.push_back(t);
+  }
+
+  for (auto const &t : threads) {
+    bool const copied = snapshotScopes(t.get(), scopes);
+    std::lock_guard const lock{s->mutex};
+    if (!copied)
+      ++s->missedSamples;
+    else if (scopes->size() == 1)
+      ++s->idleSamples;
+    else {
+      ++s->stacks[{scopes->begin(), scopes->end()}];
+      ++s->samples;
+    }
+  }
+}
+
+void runSampler(LoggerT *const l, ScopeSampler *const s) {
+  using clock_t = std::chrono::steady_clock;
+  std::chrono::nanoseconds const second{std::chrono::seconds{1}};
+  std::vector<char const *> scopes{};
+  for (auto next = clock_t::now(); !s->stop.load(std::memory_order_acquire);
+       std::this_thread::sleep_until(next)) {
+    sampleThreads(l, s, &scopes);
+    next += second / l->sampleRate.load(std::memory_order_relaxed);
+  }
+}
+
+void stopSampler(ScopeSampler *const s) {
+  s->stop.store(true, std::memory_order_release);
+  if (s->thread.joinable())
+    s->thread.join();
+}
+
+// The sampled stacks, and the number of samples at or under every path.
+std::map<std::vector<std::string>, std::size_t>
+countInclusiveSamples(SampleProfile const &profile) {
+  std::map<std::vector<std::string>, std::size_t> inclusive{};
+  for (auto const &e : profile.entries) {
+    std::vector<std::string> path{};
+    std::size_t begin = 0;
+    for (std::size_t end; (end = e.path.find(';', begin)) != std::string::npos;
+         begin = end + 1) {
+      path.push_back(e.path.substr(begin, end - begin));
+      inclusive[path] += e.samples;
+    }
+    path.push_back(e.path.substr(begin));
+    inclusive[path] += e.samples;
+  }
+  return inclusive;
+}
+} // namespace
+
+ScopeSampler::~ScopeSampler() { stopSampler(this); }
+
+// The states of exited threads are only held by the logger, and are
+// dropped once another thread registers.
+void registerThreadState(LoggerT *const l,
+                         std::shared_ptr<ThreadState> const &state) {
+  std::lock_guard const lock{l->threadsMutex};
+  std::erase_if(l->threads, [](auto const &t) { return t.use_count() == 1; });
+  l->threads.push_back(state);
+}
+
+int sampleScopes(LoggerT *const l, bool const v) {
+  if (!l)
+    return Result::ErrorNullptrParameter;
+  if (!v) {
+    if (l->sampler)
+      stopSampler(l->sampler.get());
+    return Result::Success;
+  }
+
+  if (l->sampler && l->sampler->thread.joinable())
+    return Result::Success;
+  l->sampler = std::make_unique<ScopeSampler>();
+  l->sampler->thread = std::thread{runSampler, l, l->sampler.get()};
+  return Result::Success;
+}
+
+int setSampleRate(LoggerT *const l, std::size_t const hertz) {
+  if (!l)
+    return Result::ErrorNullptrParameter;
+  if (!hertz || hertz > 1000000)
+    return Result::ErrorSampleRateNotValid;
+  l->sampleRate.store(hertz, std::memory_order_relaxed);
+  return Result::Success;
+}
+
+int getSampleProfile(LoggerT *const l, SampleProfile *const profile) {
+  if (!l || !profile)
+    return Result::ErrorNullptrParameter;
+
+  *profile = {};
+  if (!l->sampler)
+    return Result::Success;
+  auto *const s = l->sampler.get();
+  std::lock_guard const lock{s->mutex};
+  for (auto const &[scopes, samples] : s->stacks) {
+    std::string path{scopes.front()};
+    for (std::size_t i = 1; i < scopes.size(); ++i)
+      (path += ';') += scopes[i];
+    profile->entries.push_back({std::move(path), samples});
+  }
+  profile->samples = s->samples;
+  profile->idleSamples = s->idleSamples;
+  profile->missedSamples = s->missedSamples;
+  return Result::Success;
+}
+
+int printSampleProfile(LoggerT *const l) {
+  SampleProfile profile{};
+  if (int const r = getSampleProfile(l, &profile); r != Result::Success)
+    return r;
+
+  std::string const indent{"  "};
+  auto &s = std::cout;
+  s << std::fixed << std::setprecision(1);
+  for (auto const &[path, samples] : countInclusiveSamples(profile)) {
+    for (std::size_t i = 1; i < path.size(); ++i)
+      s << indent;
+    s << path.back() << ": " << samples << " samples, "
+      << 100.0 * samples / profile.samples << "%\n";
+  }
+  s << std::defaultfloat;
+  return Result::Success;
+}
+
+int writeSampledStacks(LoggerT *const l, std::string const &path) {
+  SampleProfile profile{};
+  if (int const r = getSampleProfile(l, &profile); r != Result::Success)
+    return r;
+
+  std::ofstream file{path, std::ios::trunc};
+  if (!file)
+    return Result::ErrorFileAccessFailure;
+  for (auto const &e : profile.entries)
+    file << e.path << " " << e.samples << "\n";
+  return file ? Result::Success : Result::ErrorFileAccessFailure;
+}
+} // namespace sl
@@ -0,0 +1,186 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <badline/scopedLogger.hpp>
+#include "internals.hpp"
+#include <functional>
+
+namespace sl {
+namespace {
+constexpr std::size_t locationSlotCount = 4096;
+constexpr std::size_t maxLocationProbes = 16;
+
+// The limiters of the inf, wrn and err call sites, claimed by the first
+// entry of their location, and never released. The location is written
+// before the slot is published as ready.
+struct LocationSlot {
+  enum State : std::uint8_t { Free, Claimed, Ready };
+  std::atomic<std::uint8_t> state{};
+  char const *file{};
+  std::uint_least32_t line{};
+  std::uint_least32_t column{};
+  detail::SiteLimiter limiter{};
+};
+
+LocationSlot locationSlots[locationSlotCount]{};
+
+std::uint64_t mix(std::uint64_t v) {
+  v ^= v >> 33;
+  v *= 0xff51afd7ed558ccdULL;
+  v ^= v >> 33;
+  v *= 0xc4ceb9fe1a85ec53ULL;
+  return v ^ (v >> 33);
+}
+
+/* Looks for the slot of the location among the few after its hash, and
+ * returns nullptr when they are all taken by other locations, leaving the
+ * call site free. A slot being claimed is waited for, so that one location
+ * never ends up with two limiters.
+ */
+detail::SiteLimiter *findSiteLimiter(std::source_location const &location) {
+  char const *const file = location.file_name();
+  std::uint_least32_t const line = location.line();
+  std::uint_least32_t const column = location.column();
+  std::uint64_t const hash =
+      mix(reinterpret_cast<std::uintptr_t>(file) ^
+          (std::uint64_t(line) << 32 | column));
+  for (std::size_t i = 0; i < maxLocationProbes; ++i) {
+    auto &slot = locationSlots[(hash + i) % locationSlotCount];
+    std::uint8_t state = slot.state.load(std::memory_order_acquire);
+    if (state == LocationSlot::Free &&
+        slot.state.compare_exchange_strong(state, LocationSlot::Claimed,
+                                           std::memory_order_acquire)) {
+      slot.file = file;
+      slot.line = line;
+      slot.column = column;
+      slot.state.store(LocationSlot::Ready, std::memory_order_release);
+      slot.state.notify_all();
+      return &slot.limiter;
+    }
+    while (state == LocationSlot::Claimed) {
+      slot.state.wait(state, std::memory_order_acquire);
+      state = slot.state.load(std::memory_order_acquire);
+    }
+    if (slot.file == file && slot.line == line && slot.column == column)
+      return &slot.limiter;
+  }
+  return nullptr;
+}
+
+std::int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/* Takes a token from the bucket of the call site, kept as the time its
+ * next entry is due at the rate of the limit. The bucket holds a burst of
+ * entries while that time is no further ahead than the burst allows.
+ */
+bool takeToken(detail::SiteLimiter *const site, std::int64_t const interval,
+               std::int64_t const burst) {
+  std::int64_t const now = nowNs();
+  std::int64_t next = site->nextEntryNs.load(std::memory_order_relaxed);
+  while (true) {
+    std::int64_t const due = std::max(next, now);
+    if (due - now > (burst - 1) * interval)
+      return false;
+    if (site->nextEntryNs.compare_exchange_weak(next, due + interval,
+                                                std::memory_order_relaxed))
+      return true;
+  }
+}
+} // namespace
+
+bool isSuppressionEnabled(LoggerT *const l) {
+  return l->foldDuplicates.load(std::memory_order_relaxed) ||
+         l->rateLimitIntervalNs.load(std::memory_order_relaxed);
+}
+
+// An entry is only folded into the last one its call site wrote, so that
+// the entries dropped by the rate limit don't count as written. Its text
+// is only hashed when duplicates are folded.
+bool suppressEntry(LoggerT *const l, detail::SiteLimiter *const site,
+                   std::string_view const entry,
+                   SuppressedEntries *const suppressed) {
+  bool const fold = l->foldDuplicates.load(std::memory_order_relaxed);
+  std::uint64_t const hash =
+      fold ? std::hash<std::string_view>{}(entry) | 1 : 0;
+  if (fold && site->lastEntryHash.load(std::memory_order_relaxed) == hash) {
+    site->folded.fetch_add(1, std::memory_order_relaxed);
+    l->foldedEntries.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  if (std::int64_t const interval =
+          l->rateLimitIntervalNs.load(std::memory_order_relaxed);
+      interval &&
+      !takeToken(site, interval,
+                 l->rateLimitBurst.load(std::memory_order_relaxed))) {
+    site->rateLimited.fetch_add(1, std::memory_order_relaxed);
+    l->rateLimitedEntries.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  site->lastEntryHash.store(hash, std::memory_order_relaxed);
+  suppressed->folded = site->folded.exchange(0, std::memory_order_relaxed);
+  suppressed->rateLimited =
+      site->rateLimited.exchange(0, std::memory_order_relaxed);
+  return false;
+}
+
+int logAtLocation(LoggerT *const l, std::string const &msg, int const logLevel,
+                  std::source_location const &location) {
+  SuppressedEntries suppressed{};
+  if (isSuppressionEnabled(l) && isEntryEnabled(l, logLevel))
+    if (auto *const site = findSiteLimiter(location);
+        site && suppressEntry(l, site, msg, &suppressed))
+      return Result::Success;
+  return log(l, msg, logLevel, suppressed);
+}
+
+int setRateLimit(LoggerT *const l, std::size_t const perSecond,
+                 std::size_t const burst) {
+  if (!l)
+    return Result::ErrorNullptrParameter;
+  if (perSecond > 1000000000 || burst > 1000000000 || (perSecond && !burst))
+    return Result::ErrorRateLimitNotValid;
+
+  l->rateLimitBurst.store(std::int64_t(burst), std::memory_order_relaxed);
+  l->rateLimitIntervalNs.store(perSecond ? 1000000000 / perSecond : 0,
+                               std::memory_order_relaxed);
+  return Result::Success;
+}
+
+int foldDuplicates(LoggerT *const l, bool const v) {
+  if (!l)
+    return Result::ErrorNullptrParameter;
+  l->foldDuplicates.store(v, std::memory_order_relaxed);
+  return Result::Success;
+}
+
+int getSuppressionStats(LoggerT *const l, SuppressionStats *const stats) {
+  if (!l || !stats)
+    return Result::ErrorNullptrParameter;
+  stats->rateLimited = l->rateLimitedEntries.load(std::memory_order_relaxed);
+  stats->folded = l->foldedEntries.load(std::memory_order_relaxed);
+  return Result::Success;
+}
+} // namespace sl
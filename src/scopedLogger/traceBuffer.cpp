@@ -0,0 +1,93 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <badline/scopedLogger.hpp>
+#include "internals.hpp"
+
+namespace sl {
+namespace {
+TraceRecord const &oldestRecord(Buffer const *const b) {
+  return b->records[b->first];
+}
+
+void dropOldestRecord(Buffer *const b) {
+  b->first = (b->first + 1) % b->records.size();
+  --b->count;
+}
+} // namespace
+
+void appendToTrace(Buffer *const b,
+                   std::chrono::system_clock::time_point const time,
+                   std::string_view function, std::string_view message,
+                   int const level, std::size_t const depth) {
+  if (b->records.empty()) {
+    b->records.resize(b->maxEntries);
+    b->arena.resize(
+        std::max(b->maxEntries * traceBytesPerEntry, minTraceArenaSize));
+  }
+
+  std::size_t const size = function.size() + message.size();
+  if (size > b->arena.size()) {
+    b->first = b->count = b->arenaHead = 0;
+    b->arena.resize(std::max(size, 2 * b->arena.size()));
+  }
+  std::size_t const arenaSize = b->arena.size();
+
+  std::size_t const offset = b->arenaHead % arenaSize;
+  std::size_t const start =
+      arenaSize - offset < size ? b->arenaHead + arenaSize - offset
+                                : b->arenaHead;
+  if (b->count == b->records.size())
+    dropOldestRecord(b);
+  while (b->count && start + size - oldestRecord(b).offset > arenaSize)
+    dropOldestRecord(b);
+
+  char *const data = b->arena.data() + start % arenaSize;
+  function.copy(data, function.size());
+  message.copy(data + function.size(), message.size());
+  b->arenaHead = start + size;
+
+  auto &record = b->records[(b->first + b->count) % b->records.size()];
+  record.time = time;
+  record.offset = start;
+  record.functionSize = function.size();
+  record.messageSize = message.size();
+  record.depth = depth;
+  record.type = level;
+  ++b->count;
+}
+
+// The newest records which fit are copied into the resized rings.
+int resizeTrace(Buffer *const b, std::size_t const size) {
+  Buffer resized{};
+  resized.maxEntries = size;
+  std::size_t const kept = std::min(b->count, size);
+  for (std::size_t i = b->count - kept; i < b->count; ++i) {
+    auto const &record = b->records[(b->first + i) % b->records.size()];
+    char const *const data =
+        b->arena.data() + record.offset % b->arena.size();
+    appendToTrace(&resized, record.time, {data, record.functionSize},
+                  {data + record.functionSize, record.messageSize},
+                  record.type, record.depth);
+  }
+  *b = std::move(resized);
+  return Result::Success;
+}
+} // namespace sl
@@ -0,0 +1,4 @@
+add_executable(argParserBench argParserBench.cpp)
+target_link_libraries(argParserBench argParser)
+
+add_test(NAME argParserBenchSmoke COMMAND argParserBench 1)
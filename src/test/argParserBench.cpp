@@ -0,0 +1,421 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary measures the performance of the argument parser. It takes
+ * one optional parameter, which is the minimum amount of milliseconds
+ * spent on every benchmark case (100 by default).
+ *
+ * Every case parses a generated command line of a given token shape,
+ * token length and argument count, using a fresh parser for every
+ * iteration. The cost of creating and destroying a parser is measured
+ * separately and excluded from the parsing cases. Long form abbreviations
+ * and suggestions are measured against a spec of 10000 options, next to
+ * a linear edit distance scan of the same spec.
+ *
+ * The results are printed to the standard output as a single JSON
+ * document, so that runs of different revisions can be compared.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - All the cases were parsed successfully.
+ *
+ * 1 - Invalid usage, or one of the cases failed to parse.
+ */
+
+#include <badline/argParser.hpp>
+#include <functional>
+#include <filesystem>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+
+namespace {
+using clock_t = std::chrono::steady_clock;
+
+struct SpecT {
+  std::vector<std::string> flags{};
+  std::vector<std::string> options{};
+  std::string shortFlags{};
+};
+
+struct CaseT {
+  std::string shape{};
+  std::size_t tokenLength{};
+  SpecT spec{};
+  std::vector<std::string> tokens{};
+};
+
+struct MeasurementT {
+  std::size_t iterations{};
+  double totalNs{};
+  int result{};
+};
+
+std::string const alnum{"abcdefghijklmnopqrstuvwxyz0123456789"};
+
+std::string makeName(std::size_t const length, std::size_t const seed) {
+  std::string name{};
+  for (std::size_t i = 0; i < length; ++i)
+    name += alnum[(seed * 7 + i * 13) % 26];
+  return name;
+}
+
+int createParser(SpecT const &spec, ap::ArgParserT **const handle) {
+  if (auto r = ap::createArgParser(handle); r != ap::Result::Success)
+    return r;
+  for (std::size_t i = 0; i < spec.shortFlags.size(); ++i) {
+    std::string const name = std::string{"short"} + spec.shortFlags[i];
+    if (auto r = ap::addFlag(*handle, name, spec.shortFlags[i]);
+        r != ap::Result::Success)
+      return r;
+  }
+  for (auto const &f : spec.flags)
+    if (auto r = ap::addFlag(*handle, f); r != ap::Result::Success)
+      return r;
+  for (auto const &o : spec.options)
+    if (auto r = ap::addOption(*handle, o); r != ap::Result::Success)
+      return r;
+  return ap::Result::Success;
+}
+
+MeasurementT measure(double const minNs, std::function<int()> const &fn) {
+  MeasurementT m{};
+  while (m.totalNs < minNs) {
+    auto const start = clock_t::now();
+    m.result = fn();
+    auto const d = clock_t::now() - start;
+    m.totalNs += std::chrono::duration<double, std::nano>(d).count();
+    ++m.iterations;
+    if (m.result != ap::Result::Success)
+      break;
+  }
+  return m;
+}
+
+MeasurementT runCase(CaseT const &c, double const minNs) {
+  std::vector<char const *> argv{};
+  for (auto const &t : c.tokens)
+    argv.push_back(t.c_str());
+
+  MeasurementT m{};
+  while (m.totalNs < minNs) {
+    ap::ArgParserT *handle{};
+    if (m.result = createParser(c.spec, &handle);
+        m.result != ap::Result::Success)
+      break;
+
+    auto const start = clock_t::now();
+    m.result = ap::parse(handle, argv.data(), 0, argv.size());
+    auto const d = clock_t::now() - start;
+    ap::destroyArgParser(handle);
+
+    m.totalNs += std::chrono::duration<double, std::nano>(d).count();
+    ++m.iterations;
+    if (m.result != ap::Result::Success)
+      break;
+  }
+  return m;
+}
+
+CaseT makeShortCluster(std::size_t const length, std::size_t const argc) {
+  CaseT c{"shortCluster", length};
+  c.spec.shortFlags = alnum.substr(0, length - 1);
+  for (std::size_t i = 0; i < argc; ++i)
+    c.tokens.push_back("-" + c.spec.shortFlags);
+  return c;
+}
+
+CaseT makeLongExtended(std::size_t const length, std::size_t const argc) {
+  CaseT c{"longExtended", length};
+  std::size_t const body = length - 2;
+  std::string name = makeName(body, 1);
+  for (std::size_t i = 3; i + 2 < body; i += 4)
+    name[i] = (i / 4) % 2 ? '-' : '_';
+  c.spec.flags.push_back(name);
+  for (std::size_t i = 0; i < argc; ++i)
+    c.tokens.push_back("--" + name);
+  return c;
+}
+
+// A long form and a value each take at least two characters, so the
+// shortest assignment is longer than the requested length.
+CaseT makeAssignment(std::size_t const length, std::size_t const argc) {
+  std::size_t const body = length - 3;
+  std::size_t const nameLength = std::max<std::size_t>(body / 2, 2);
+  std::size_t const valueLength = std::max<std::size_t>(body - nameLength, 2);
+  CaseT c{"assignment", 3 + nameLength + valueLength};
+  std::string const name = makeName(nameLength, 2);
+  c.spec.options.push_back(name);
+  for (std::size_t i = 0; i < argc; ++i)
+    c.tokens.push_back("--" + name + "=" + makeName(valueLength, i));
+  return c;
+}
+
+CaseT makeFreeValue(std::size_t const length, std::size_t const argc) {
+  CaseT c{"freeValue", length};
+  for (std::size_t i = 0; i < argc; ++i)
+    c.tokens.push_back("/" + makeName(length - 1, i));
+  return c;
+}
+
+std::size_t editDistance(std::string const &a, std::string const &b) {
+  std::vector<std::size_t> row(b.size() + 1);
+  for (std::size_t j = 0; j <= b.size(); ++j)
+    row[j] = j;
+  for (std::size_t i = 1; i <= a.size(); ++i) {
+    std::size_t diagonal = row[0];
+    row[0] = i;
+    for (std::size_t j = 1; j <= b.size(); ++j) {
+      std::size_t const up = row[j];
+      row[j] = std::min({row[j] + 1, row[j - 1] + 1,
+                         diagonal + (a[i - 1] != b[j - 1])});
+      diagonal = up;
+    }
+  }
+  return row[b.size()];
+}
+
+// Cases over a spec of 10000 long options, comparing the trie used for
+// abbreviations and suggestions against a linear scan of the names.
+struct LargeSpecT {
+  std::vector<std::string> names{};
+  std::vector<std::string> prefixes{};
+  std::vector<std::string> typos{};
+};
+
+LargeSpecT makeLargeSpec() {
+  LargeSpecT spec{};
+  for (std::size_t i = 0; i < 10000; ++i)
+    spec.names.push_back(makeName(6, i % 97) + std::to_string(i) + "opt");
+  for (std::size_t i = 0; i < 16; ++i) {
+    auto const &name = spec.names[i * 611];
+    spec.prefixes.push_back("--" + name.substr(0, name.size() - 2));
+    std::string typo = name;
+    std::swap(typo[1], typo[2]);
+    spec.typos.push_back("--" + typo);
+  }
+  return spec;
+}
+
+ap::ArgParserT *createLargeParser(LargeSpecT const &spec) {
+  ap::ArgParserT *handle{};
+  ap::createArgParser(&handle);
+  for (auto const &name : spec.names)
+    ap::addOption(handle, name);
+  ap::allowLongFormAbbreviations(handle, true);
+  return handle;
+}
+
+void printResult(std::string const &name, std::size_t const tokenLength,
+                 std::size_t const argc, MeasurementT const &m,
+                 bool const last) {
+  std::string result{};
+  ap::Result::toString(m.result, &result);
+  double const perIteration = m.iterations ? m.totalNs / m.iterations : 0;
+  double const perToken = argc ? perIteration / argc : perIteration;
+
+  std::cout << "    {\"name\": \"" << name << "\", ";
+  std::cout << "\"tokenLength\": " << tokenLength << ", ";
+  std::cout << "\"argc\": " << argc << ", ";
+  std::cout << "\"iterations\": " << m.iterations << ", ";
+  std::cout << "\"nsPerIteration\": " << perIteration << ", ";
+  std::cout << "\"nsPerToken\": " << perToken << ", ";
+  std::cout << "\"tokensPerSec\": " << (perToken ? 1e9 / perToken : 0)
+            << ", ";
+  std::cout << "\"result\": \"" << result << "\"}" << (last ? "\n" : ",\n");
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc > 2) {
+    std::cerr << "Too many arguments; Usage: [minMillisPerCase]\n";
+    return 1;
+  }
+
+  double const minNs = (argc == 2 ? std::stod(argv[1]) : 100.0) * 1e6;
+  std::vector<CaseT> cases{};
+
+  using MakerT = CaseT (*)(std::size_t const, std::size_t const);
+  for (MakerT const make :
+       {makeShortCluster, makeLongExtended, makeAssignment, makeFreeValue})
+    for (std::size_t const length : {6, 8, 16, 32})
+      cases.push_back(make(length, 16));
+
+  for (std::size_t const count : {1, 16, 256})
+    cases.push_back(makeAssignment(16, count));
+
+  int status = 0;
+  std::cout << "{\n  \"benchmark\": \"argParser\",\n  \"results\": [\n";
+
+  auto const lifetime = measure(minNs, [] {
+    ap::ArgParserT *handle{};
+    int const r = ap::createArgParser(&handle);
+    ap::destroyArgParser(handle);
+    return r;
+  });
+  printResult("createDestroy", 0, 0, lifetime, false);
+
+  for (auto const &c : cases) {
+    auto const m = runCase(c, minNs);
+    if (m.result != ap::Result::Success)
+      status = 1;
+    printResult(c.shape, c.tokenLength, c.tokens.size(), m, false);
+  }
+
+  auto const large = makeLargeSpec();
+  auto *const handle = createLargeParser(large);
+
+  auto const build =
+      measure(minNs, [handle] { return ap::freezeSpec(handle); });
+  printResult("trieBuild10k", 0, 0, build, false);
+
+  auto const specPath =
+      (std::filesystem::temp_directory_path() / "argParserBench.spec").string();
+  ap::saveSpec(handle, specPath);
+
+  auto const registration = measure(minNs, [&large] {
+    auto *const h = createLargeParser(large);
+    int const r = ap::freezeSpec(h);
+    ap::destroyArgParser(h);
+    return r;
+  });
+  printResult("specRegister10k", 0, 0, registration, false);
+
+  auto const load = measure(minNs, [&specPath] {
+    ap::ArgParserT *h{};
+    ap::createArgParser(&h);
+    int const r = ap::loadSpec(h, specPath);
+    ap::destroyArgParser(h);
+    return r;
+  });
+  printResult("specLoad10k", 0, 0, load, false);
+  std::filesystem::remove(specPath);
+
+  auto const abbreviation = measure(minNs, [&large, handle] {
+    for (auto const &prefix : large.prefixes) {
+      char const *const argv[] = {prefix.c_str(), "value"};
+      if (auto r = ap::parse(handle, argv, 0, 2); r != ap::Result::Success)
+        return r;
+    }
+    return int(ap::Result::Success);
+  });
+  printResult("abbreviation10k", 0, large.prefixes.size(), abbreviation,
+              false);
+
+  auto const suggestion = measure(minNs, [&large, handle] {
+    std::string output{};
+    for (auto const &typo : large.typos) {
+      char const *const argv[] = {typo.c_str()};
+      ap::parse(handle, argv, 0, 1);
+      ap::getLongFormSuggestion(handle, &output);
+      if (output.empty())
+        return int(ap::Result::ErrorArgLongFormNotValid);
+    }
+    return int(ap::Result::Success);
+  });
+  printResult("suggestion10k", 0, large.typos.size(), suggestion, false);
+
+  auto const linear = measure(minNs, [&large] {
+    for (auto const &typo : large.typos) {
+      std::size_t best = ~std::size_t{};
+      for (auto const &name : large.names)
+        best = std::min(best, editDistance(typo.substr(2), name));
+      if (best > 2)
+        return int(ap::Result::ErrorArgLongFormNotValid);
+    }
+    return int(ap::Result::Success);
+  });
+  printResult("suggestionLinear10k", 0, large.typos.size(), linear, false);
+
+  // Every prefix is typed one character at a time, with a completion
+  // query after each keypress.
+  std::size_t keypresses = 0;
+  for (auto const &prefix : large.prefixes)
+    keypresses += prefix.size() - 2;
+
+  auto const completion = measure(minNs, [&large, handle] {
+    std::vector<std::string> candidates{};
+    for (auto const &prefix : large.prefixes) {
+      for (std::size_t length = 3; length <= prefix.size(); ++length) {
+        std::string const word = prefix.substr(0, length);
+        char const *const argv[] = {"value", word.c_str()};
+        if (auto r = ap::complete(handle, argv, 0, 2, 1, &candidates);
+            r != ap::Result::Success)
+          return r;
+      }
+      if (candidates.size() != 1)
+        return int(ap::Result::ErrorArgLongFormAmbiguous);
+    }
+    return int(ap::Result::Success);
+  });
+  printResult("completionTyped10k", 0, keypresses, completion, false);
+  ap::destroyArgParser(handle);
+
+  // A CLI of 150 subcommands with 20 options each, invoked with one of
+  // them, registered either eagerly or through lazy subcommand specs.
+  std::vector<std::string> subcommandArgv{"cmd75", "--cmd75opt3", "value"};
+  std::vector<char const *> subcommandInput{};
+  for (auto const &t : subcommandArgv)
+    subcommandInput.push_back(t.c_str());
+
+  auto const eager = measure(minNs, [&subcommandInput] {
+    ap::ArgParserT *handle{};
+    ap::createArgParser(&handle);
+    for (std::size_t c = 0; c < 150; ++c)
+      for (std::size_t o = 0; o < 20; ++o)
+        ap::addOption(handle,
+                      "cmd" + std::to_string(c) + "opt" + std::to_string(o));
+    int const r =
+        ap::parse(handle, subcommandInput.data(), 1, subcommandInput.size());
+    ap::destroyArgParser(handle);
+    return r;
+  });
+  printResult("subcommandEager150", 0, subcommandInput.size(), eager, false);
+
+  auto const lazy = measure(minNs, [&subcommandInput] {
+    ap::ArgParserT *handle{};
+    ap::createArgParser(&handle);
+    for (std::size_t c = 0; c < 150; ++c) {
+      std::string const name = "cmd" + std::to_string(c);
+      ap::addSubcommand(handle, name, [name](ap::ArgParserT *const sub) {
+        for (std::size_t o = 0; o < 20; ++o)
+          ap::addOption(sub, name + "opt" + std::to_string(o));
+        return int(ap::Result::Success);
+      });
+    }
+    int const r =
+        ap::parse(handle, subcommandInput.data(), 0, subcommandInput.size());
+    ap::destroyArgParser(handle);
+    return r;
+  });
+  printResult("subcommandLazy150", 0, subcommandInput.size(), lazy, true);
+
+  for (auto const *m : {&build, &registration, &load, &abbreviation,
+                        &suggestion, &linear, &completion, &eager, &lazy})
+    if (m->result != ap::Result::Success)
+      status = 1;
+
+  std::cout << "  ]\n}" << std::endl;
+  return status;
+}
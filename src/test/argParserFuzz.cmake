@@ -0,0 +1,18 @@
+option(BADLINE_LIBFUZZER "Build argParserFuzz as a libFuzzer target" OFF)
+
+add_executable(argParserFuzz argParserFuzz.cpp)
+target_link_libraries(argParserFuzz argParser)
+
+# The smoke run only checks that the fuzzer works, so its time budget is
+# loose enough for a loaded machine.
+if (BADLINE_LIBFUZZER)
+	target_compile_definitions(argParserFuzz PRIVATE BADLINE_LIBFUZZER)
+	target_compile_options(argParserFuzz PRIVATE -fsanitize=fuzzer)
+	target_link_options(argParserFuzz PRIVATE -fsanitize=fuzzer)
+	add_test(NAME argParserFuzzSmoke COMMAND argParserFuzz -runs=200 -max_len=32)
+	set_tests_properties(argParserFuzzSmoke PROPERTIES
+		ENVIRONMENT "BADLINE_FUZZ_NS_PER_BYTE=1000000")
+else()
+	add_test(NAME argParserFuzzSmoke COMMAND argParserFuzz --runs 200
+		--max-len 32 --ns-per-byte 1000000 --out ${CMAKE_CURRENT_BINARY_DIR})
+endif()
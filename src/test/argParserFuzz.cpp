@@ -0,0 +1,257 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary searches for tokens that are expensive to parse. Every input
+ * is parsed as a single token, and the time and the amount of memory
+ * allocated by 'ap::parse' are measured. An input is considered
+ * pathological when either of them, divided by the input length,
+ * exceeds its budget.
+ *
+ * When built with BADLINE_LIBFUZZER, the binary is a libFuzzer target.
+ * The budgets are read from the BADLINE_FUZZ_NS_PER_BYTE and
+ * BADLINE_FUZZ_ALLOC_PER_BYTE environment variables, and an input which
+ * exceeds them aborts, so that libFuzzer saves and minimizes it.
+ *
+ * Otherwise the binary is a standalone fuzzer accepting these parameters:
+ *
+ *   --runs <count>            number of random inputs (10000)
+ *   --max-len <bytes>         maximum length of a random input (64)
+ *   --seed <value>            seed of the random generator (1)
+ *   --ns-per-byte <ns>        time budget per input byte (20000)
+ *   --alloc-per-byte <bytes>  allocation budget per input byte (65536)
+ *   --out <dir>               where the minimized inputs are saved (.)
+ *   <file>...                 replay the given inputs instead of fuzzing
+ *
+ * Pathological inputs are greedily minimized, by removing chunks of bytes
+ * as long as the input still exceeds a budget, and saved as 'slow-<hash>'.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - No input exceeded the budgets.
+ *
+ * 1 - Invalid usage, or at least one input exceeded the budgets.
+ */
+
+#include <badline/argParser.hpp>
+#include <functional>
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <atomic>
+#include <new>
+
+namespace {
+std::atomic<bool> trackAllocations{false};
+std::atomic<std::size_t> allocatedBytes{0};
+} // namespace
+
+void *operator new(std::size_t const size) {
+  if (trackAllocations.load(std::memory_order_relaxed))
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size ? size : 1); ptr)
+    return ptr;
+  throw std::bad_alloc{};
+}
+
+void operator delete(void *const ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *const ptr, std::size_t const) noexcept {
+  std::free(ptr);
+}
+
+namespace {
+struct BudgetT {
+  double nsPerByte{20000};
+  double allocPerByte{65536};
+};
+
+struct CostT {
+  double ns{};
+  std::size_t allocated{};
+  int result{};
+};
+
+CostT measure(std::string const &input) {
+  ap::ArgParserT *handle{};
+  ap::createArgParser(&handle);
+  ap::addFlag(handle, "flag", 'f');
+  ap::addOption(handle, "option", 'o');
+
+  char const *const argv[] = {input.c_str()};
+  CostT cost{};
+
+  allocatedBytes = 0;
+  trackAllocations = true;
+  auto const start = std::chrono::steady_clock::now();
+  cost.result = ap::parse(handle, argv, 0, 1);
+  auto const d = std::chrono::steady_clock::now() - start;
+  trackAllocations = false;
+
+  cost.ns = std::chrono::duration<double, std::nano>(d).count();
+  cost.allocated = allocatedBytes;
+  ap::destroyArgParser(handle);
+  return cost;
+}
+
+bool exceedsBudget(std::string const &input, BudgetT const &budget,
+                   CostT *const cost) {
+  *cost = measure(input);
+  double const bytes = input.size() ? input.size() : 1;
+  return cost->ns / bytes > budget.nsPerByte ||
+         cost->allocated / bytes > budget.allocPerByte;
+}
+
+std::string minimize(std::string input, BudgetT const &budget) {
+  CostT cost{};
+  for (std::size_t chunk = input.size() / 2; chunk; chunk /= 2) {
+    for (std::size_t at = 0; at + chunk <= input.size();) {
+      std::string candidate = input;
+      candidate.erase(at, chunk);
+      if (candidate.size() && exceedsBudget(candidate, budget, &cost))
+        input = std::move(candidate);
+      else
+        at += chunk;
+    }
+  }
+  return input;
+}
+
+void report(std::string const &input, CostT const &cost) {
+  std::string result{};
+  ap::Result::toString(cost.result, &result);
+  std::cout << "length: " << input.size() << " ns: " << cost.ns
+            << " allocated: " << cost.allocated << " result: " << result
+            << " input: '" << input << "'" << std::endl;
+}
+
+std::string makeInput(std::mt19937_64 &rng, std::size_t const maxLength) {
+  // Structural characters of the grammar are overrepresented, since they
+  // are the ones multiplying the number of derivations.
+  std::string const alphabet{"--__==aZ09xX/.,:"};
+  std::uniform_int_distribution<std::size_t> length{2, maxLength};
+  std::uniform_int_distribution<int> printable{33, 126};
+  std::uniform_int_distribution<std::size_t> pick{0, alphabet.size() - 1};
+
+  std::string input(length(rng), ' ');
+  for (auto &c : input)
+    c = rng() % 2 ? alphabet[pick(rng)] : char(printable(rng));
+  return input;
+}
+
+bool save(std::string const &dir, std::string const &input) {
+  std::string const name =
+      dir + "/slow-" + std::to_string(std::hash<std::string>{}(input));
+  std::ofstream file{name, std::ios::binary};
+  file << input;
+  return file.good();
+}
+} // namespace
+
+#ifdef BADLINE_LIBFUZZER
+extern "C" int LLVMFuzzerTestOneInput(std::uint8_t const *data,
+                                      std::size_t size) {
+  static BudgetT const budget = [] {
+    BudgetT b{};
+    if (char const *v = std::getenv("BADLINE_FUZZ_NS_PER_BYTE"))
+      b.nsPerByte = std::stod(v);
+    if (char const *v = std::getenv("BADLINE_FUZZ_ALLOC_PER_BYTE"))
+      b.allocPerByte = std::stod(v);
+    return b;
+  }();
+
+  std::string input{reinterpret_cast<char const *>(data), size};
+  input = input.substr(0, input.find('\0'));
+  if (input.empty())
+    return 0;
+
+  if (CostT cost{}; exceedsBudget(input, budget, &cost)) {
+    report(input, cost);
+    std::abort();
+  }
+  return 0;
+}
+#else
+int main(int const argc, char const *const *const argv) {
+  BudgetT budget{};
+  std::size_t runs{10000}, maxLength{64}, seed{1};
+  std::string out{"."};
+  std::vector<std::string> files{};
+
+  for (int i = 1; i < argc; ++i) {
+    std::string const arg = argv[i];
+    if (arg.rfind("--", 0) == 0 && i + 1 == argc) {
+      std::cerr << "Missing value of '" << arg << "'\n";
+      return 1;
+    }
+
+    if (arg == "--runs")
+      runs = std::stoull(argv[++i]);
+    else if (arg == "--max-len")
+      maxLength = std::max<std::size_t>(2, std::stoull(argv[++i]));
+    else if (arg == "--seed")
+      seed = std::stoull(argv[++i]);
+    else if (arg == "--ns-per-byte")
+      budget.nsPerByte = std::stod(argv[++i]);
+    else if (arg == "--alloc-per-byte")
+      budget.allocPerByte = std::stod(argv[++i]);
+    else if (arg == "--out")
+      out = argv[++i];
+    else
+      files.push_back(arg);
+  }
+
+  int status = 0;
+  CostT cost{};
+
+  if (files.size()) {
+    for (auto const &f : files) {
+      std::ifstream file{f, std::ios::binary};
+      std::string input{std::istreambuf_iterator<char>{file}, {}};
+      input = input.substr(0, input.find('\0'));
+      if (exceedsBudget(input, budget, &cost))
+        status = 1;
+      report(input, cost);
+    }
+    return status;
+  }
+
+  std::mt19937_64 rng{seed};
+  for (std::size_t run = 0; run < runs; ++run) {
+    auto const input = makeInput(rng, maxLength);
+    if (!exceedsBudget(input, budget, &cost))
+      continue;
+
+    auto const minimized = minimize(input, budget);
+    exceedsBudget(minimized, budget, &cost);
+    report(minimized, cost);
+    if (!save(out, minimized))
+      std::cerr << "Failed to save the input to '" << out << "'\n";
+    status = 1;
+  }
+  return status;
+}
+#endif
@@ -0,0 +1,7 @@
+add_executable(completionServer completionServer.cpp)
+target_link_libraries(completionServer argParser)
+
+add_test(NAME completionServerTest0001 COMMAND ${CMAKE_COMMAND}
+	-DSERVER=$<TARGET_FILE:completionServer>
+	-DWORK_DIR=${CMAKE_CURRENT_BINARY_DIR}
+	-P ${CMAKE_CURRENT_SOURCE_DIR}/completionServerExchange.cmake)
@@ -0,0 +1,183 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * A completion server for a spec given as declarations on the command
+ * line. Every declaration is one of:
+ *
+ *   spec:<path>                       a spec written by 'saveSpec'
+ *   flag:<long>[:<short>]             a flag
+ *   option:<long>[:<short>]           an option
+ *   choices:<option>:<value>[,...]    the values offered for an option
+ *
+ * A declaration prefixed with '<name>/' belongs to the subcommand of that
+ * name, whose spec applies it when the subcommand is first met. The spec
+ * is built once, and every line read from the standard input is then
+ * split into tokens the way 'parseCommandString' does it and completed:
+ * the last token is completed, or a new token if a blank follows it.
+ *
+ * The candidates are written one per line, followed by an empty line,
+ * or 'error: <result>' when the line can't be completed. A shell may keep
+ * the server running as a coprocess, so that keypresses are answered by
+ * the already built parser.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The standard input was closed.
+ *
+ * 1 - A declaration is not valid, or the spec couldn't be built.
+ */
+
+#include <argParser/internals.hpp>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+struct DeclarationT {
+  std::string kind{};
+  std::vector<std::string> fields{};
+};
+
+std::vector<std::string> split(std::string const &text, char const separator) {
+  std::vector<std::string> parts{};
+  std::size_t begin = 0;
+  for (std::size_t end; (end = text.find(separator, begin)) != text.npos;
+       begin = end + 1)
+    parts.push_back(text.substr(begin, end - begin));
+  parts.push_back(text.substr(begin));
+  return parts;
+}
+
+// The path of a spec is taken whole, as it may contain colons.
+bool parseDeclaration(std::string const &text, DeclarationT *const output) {
+  auto const colon = text.find(':');
+  output->kind = text.substr(0, colon);
+  if (colon == text.npos)
+    return false;
+  if (output->kind == "spec") {
+    output->fields = {text.substr(colon + 1)};
+    return true;
+  }
+
+  auto const fields = split(text.substr(colon + 1), ':');
+  output->fields = fields;
+  if (output->kind == "flag" || output->kind == "option")
+    return fields.size() == 1 || (fields.size() == 2 && fields[1].size() == 1);
+  if (output->kind == "choices")
+    return fields.size() == 2;
+  return false;
+}
+
+int declare(ap::ArgParserT *const handle,
+            std::vector<DeclarationT> const &declarations) {
+  for (auto const &[kind, fields] : declarations) {
+    char const shortForm = fields.size() == 2 ? fields[1][0] : '\0';
+    int r = ap::Result::Success;
+    if (kind == "spec")
+      r = ap::loadSpec(handle, fields[0]);
+    else if (kind == "flag")
+      r = ap::addFlag(handle, fields[0], shortForm);
+    else if (kind == "option")
+      r = ap::addOption(handle, fields[0], shortForm);
+    else
+      r = ap::setOptionValueChoices(handle, fields[0], split(fields[1], ','));
+    if (r != ap::Result::Success)
+      return r;
+  }
+  return ap::Result::Success;
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc < 2) {
+    std::cerr << "Too few arguments; Usage: <declaration>...\n";
+    return 1;
+  }
+
+  std::vector<DeclarationT> declarations{};
+  std::map<std::string, std::vector<DeclarationT>> subcommands{};
+  for (int i = 1; i < argc; ++i) {
+    std::string text = argv[i];
+    std::string subcommand{};
+    if (auto const slash = text.find('/'); slash < text.find(':')) {
+      subcommand = text.substr(0, slash);
+      text.erase(0, slash + 1);
+    }
+
+    DeclarationT declaration{};
+    if (!parseDeclaration(text, &declaration)) {
+      std::cerr << "Invalid declaration: " << argv[i] << std::endl;
+      return 1;
+    }
+    if (subcommand.empty())
+      declarations.push_back(declaration);
+    else
+      subcommands[subcommand].push_back(declaration);
+  }
+
+  ap::ArgParserT *handle{};
+  if (auto r = ap::createArgParser(&handle); r != ap::Result::Success)
+    return 1;
+  int r = declare(handle, declarations);
+  for (auto const &[name, spec] : subcommands)
+    if (r == ap::Result::Success)
+      r = ap::addSubcommand(handle, name,
+                            [spec](ap::ArgParserT *const subcommand) {
+                              return declare(subcommand, spec);
+                            });
+  if (r != ap::Result::Success) {
+    std::string result{};
+    ap::Result::toString(r, &result);
+    std::cerr << "Failed to build the spec: " << result << std::endl;
+    ap::destroyArgParser(handle);
+    return 1;
+  }
+
+  std::string line{};
+  ap::CommandTokensT tokens{};
+  std::vector<std::string> candidates{};
+
+  while (std::getline(std::cin, line)) {
+    r = ap::tokenize(line, &tokens);
+    if (r == ap::Result::Success) {
+      std::size_t const cursor =
+          tokens.argv.size() - (tokens.endsInToken ? 1 : 0);
+      r = ap::complete(handle, tokens.argv.data(), 0, tokens.argv.size(),
+                       cursor, &candidates);
+    }
+
+    if (r != ap::Result::Success) {
+      std::string result{};
+      ap::Result::toString(r, &result);
+      std::cout << "error: " << result << "\n\n" << std::flush;
+      continue;
+    }
+
+    for (auto const &candidate : candidates)
+      std::cout << candidate << '\n';
+    std::cout << std::endl;
+  }
+
+  ap::destroyArgParser(handle);
+  return 0;
+}
@@ -0,0 +1,36 @@
+# Runs completionServer on the declarations of the subcommand and choices
+# test, feeds it the queries, and compares its answers with the expected
+# ones. It is a script run by ctest, given SERVER and WORK_DIR.
+
+set(queries
+	"--level "
+	"--level \"i\""
+	"--level de\\ "
+	"b"
+	"build --jobs "
+	"build --jobs 'x"
+	"build --j")
+set(expected
+	"debug\ninfo\nwarn\n\n"
+	"info\n\n"
+	"\n"
+	"bench\nbuild\n\n"
+	"1\n2\n4\n\n"
+	"error: ErrorQuoteNotTerminated\n\n"
+	"--jobs\n\n")
+
+string(JOIN "\n" input ${queries})
+string(JOIN "" output ${expected})
+file(WRITE "${WORK_DIR}/completionServerExchange.in" "${input}\n")
+
+execute_process(
+	COMMAND "${SERVER}" flag:verbose:v option:level:l
+		choices:level:debug,info,warn build/flag:release build/option:jobs:j
+		build/choices:jobs:1,2,4 bench/flag:quick
+	INPUT_FILE "${WORK_DIR}/completionServerExchange.in"
+	OUTPUT_VARIABLE answers
+	RESULT_VARIABLE result)
+
+if (NOT result EQUAL 0 OR NOT answers STREQUAL output)
+	message(FATAL_ERROR "Exit status ${result}, answers:\n${answers}")
+endif()
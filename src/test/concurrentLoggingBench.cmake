@@ -0,0 +1,2 @@
+add_executable(concurrentLoggingBench concurrentLoggingBench.cpp)
+target_link_libraries(concurrentLoggingBench scopedLogger)
@@ -0,0 +1,130 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary measures how logging through one shared logger scales with
+ * the number of threads. It takes one optional parameter, which is the
+ * number of messages logged by every thread (100000 by default).
+ *
+ * Every case starts the threads at once, and each of them enters a scope
+ * and logs its messages into a temporary file, either writing the entries
+ * itself or handing them to the writer thread. The aggregate throughput
+ * and its ratio to the single threaded case are reported.
+ *
+ * The results are printed to the standard output as a single JSON
+ * document, so that runs of different revisions can be compared.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - All the cases ran.
+ *
+ * 1 - Invalid usage, or a logger couldn't be created.
+ */
+
+#include <badline/scopedLogger.hpp>
+#include <atomic>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <chrono>
+
+namespace {
+using clock_t = std::chrono::steady_clock;
+
+// Returns the messages written per second, over all the threads; the
+// ones dropped by a full queue don't count.
+double measure(bool const async, std::size_t const threads,
+               std::size_t const count) {
+  auto const path = (std::filesystem::temp_directory_path() /
+                     "concurrentLoggingBench.log")
+                        .string();
+  std::filesystem::remove(path);
+
+  sl::LoggerT *logger{};
+  if (sl::createLogger(&logger, "bench") != sl::Result::Success)
+    return 0;
+  sl::outputToConsole(logger, false);
+  sl::outputToFile(logger, true);
+  sl::setLogFile(logger, path);
+  sl::resizeLogQueue(logger, 1 << 16);
+  sl::writeAsync(logger, async);
+
+  std::atomic<bool> go{};
+  std::vector<std::thread> workers{};
+  for (std::size_t t = 0; t < threads; ++t)
+    workers.emplace_back([&, t] {
+      sl::FunctionScope const scope{logger, "worker" + std::to_string(t)};
+      std::string const message(32, 'm');
+      while (!go)
+        std::this_thread::yield();
+      for (std::size_t i = 0; i < count; ++i)
+        sl::inf(logger, message);
+    });
+
+  auto const start = clock_t::now();
+  go = true;
+  for (auto &worker : workers)
+    worker.join();
+  sl::flushLogFile(logger);
+  std::chrono::duration<double> const d = clock_t::now() - start;
+  sl::LogQueueStats stats{};
+  sl::getLogQueueStats(logger, &stats);
+
+  sl::destroyLogger(logger);
+  std::filesystem::remove(path);
+  return (threads * count - stats.dropped) / d.count();
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc > 2) {
+    std::cerr << "Too many arguments; Usage: [messagesPerThread]\n";
+    return 1;
+  }
+
+  std::size_t const count = argc == 2 ? std::stoul(argv[1]) : 100000;
+  std::vector<std::size_t> const threadCounts{1, 2, 4, 8};
+  int status = 0;
+
+  std::cout << "{\n  \"benchmark\": \"concurrentLogging\",\n";
+  std::cout << "  \"hardwareThreads\": " << std::thread::hardware_concurrency()
+            << ",\n  \"results\": [\n";
+  for (bool const async : {false, true}) {
+    double single{};
+    for (std::size_t const threads : threadCounts) {
+      double const rate = measure(async, threads, count);
+      status |= !rate;
+      if (threads == 1)
+        single = rate;
+
+      std::cout << "    {\"name\": \"" << (async ? "async" : "sync")
+                << "\", ";
+      std::cout << "\"threads\": " << threads << ", ";
+      std::cout << "\"messagesPerSecond\": " << rate << ", ";
+      std::cout << "\"scaling\": " << (single ? rate / single : 0) << "}"
+                << (async && threads == threadCounts.back() ? "\n" : ",\n");
+    }
+  }
+  std::cout << "  ]\n}" << std::endl;
+  return status;
+}
@@ -0,0 +1,2 @@
+add_executable(functionScopeBench functionScopeBench.cpp)
+target_link_libraries(functionScopeBench scopedLogger)
@@ -0,0 +1,96 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary measures the cost of entering and leaving a FunctionScope.
+ * It takes one optional parameter, which is the number of scopes entered
+ * by every case (10000000 by default).
+ *
+ * The scopes are named by a string literal, which is kept by its address,
+ * and by a string, which is interned, and then by a string literal in the
+ * profiling mode, into a buffer holding up to a million of them. Every scope
+ * is nested in another one, as in a call tree, and nothing is logged.
+ *
+ * The results are printed to the standard output as a single JSON
+ * document.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - All the cases ran.
+ *
+ * 1 - Invalid usage, or a logger couldn't be created.
+ */
+
+#include <badline/scopedLogger.hpp>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <chrono>
+
+namespace {
+using clock_t = std::chrono::steady_clock;
+
+// Returns the nanoseconds per scope entered and left.
+template <typename F> double measure(std::size_t const count, F const &enter) {
+  auto const start = clock_t::now();
+  for (std::size_t i = 0; i < count; ++i)
+    enter();
+  auto const d = clock_t::now() - start;
+  return std::chrono::duration<double, std::nano>(d).count() / count;
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc > 2) {
+    std::cerr << "Too many arguments; Usage: [scopesPerCase]\n";
+    return 1;
+  }
+
+  std::size_t const count = argc == 2 ? std::stoul(argv[1]) : 10000000;
+  sl::LoggerT *logger{};
+  if (sl::createLogger(&logger, "bench") != sl::Result::Success)
+    return 1;
+
+  std::string const name{"function"};
+  double literalNs{}, stringNs{}, profiledNs{};
+  {
+    sl::FunctionScope const outer{logger, "outer"};
+    literalNs =
+        measure(count, [&] { sl::FunctionScope const s{logger, "function"}; });
+    stringNs = measure(count, [&] { sl::FunctionScope const s{logger, name}; });
+  }
+  std::size_t const profiled = std::min<std::size_t>(count, 1000000);
+  if (sl::resizeProfileBuffer(logger, 2 * profiled) == sl::Result::Success &&
+      sl::profileScopes(logger, true) == sl::Result::Success)
+    profiledNs = measure(
+        profiled, [&] { sl::FunctionScope const s{logger, "function"}; });
+
+  std::cout << "{\n  \"benchmark\": \"functionScope\",\n  \"results\": [\n";
+  std::cout << "    {\"name\": \"literal\", \"nsPerScope\": " << literalNs
+            << "},\n";
+  std::cout << "    {\"name\": \"string\", \"nsPerScope\": " << stringNs
+            << "},\n";
+  std::cout << "    {\"name\": \"profiled\", \"nsPerScope\": " << profiledNs
+            << "}\n";
+  std::cout << "  ]\n}" << std::endl;
+  sl::destroyLogger(logger);
+  return 0;
+}
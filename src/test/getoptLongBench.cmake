@@ -0,0 +1,2 @@
+add_executable(getoptLongBench getoptLongBench.cpp)
+target_link_libraries(getoptLongBench argParser)
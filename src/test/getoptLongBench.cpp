@@ -0,0 +1,181 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary measures 'ap_getopt_long' against the getopt_long of the C
+ * library. It takes one optional parameter, which is the minimum amount
+ * of milliseconds spent on every benchmark case (100 by default).
+ *
+ * Every case scans a generated command line of a given shape and argument
+ * count, against a table of 64 long options, with both implementations.
+ * The shapes are short option clusters, long options with and without
+ * values, and long options interleaved with non options, which have to
+ * be permuted.
+ *
+ * The results are printed to the standard output as a single JSON
+ * document, with the speedup of 'ap_getopt_long' for every case.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - Both implementations returned the same options for every case.
+ *
+ * 1 - Invalid usage, or the implementations returned different options.
+ */
+
+#include <badline/getoptLong.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+
+namespace {
+using clock_t = std::chrono::steady_clock;
+using GetoptT = int (*)(int, char *const[], char const *, option const *,
+                        int *);
+
+struct CaseT {
+  std::string shape{};
+  std::vector<std::string> arguments{};
+};
+
+struct MeasurementT {
+  std::size_t iterations{};
+  double totalNs{};
+  std::size_t checksum{};
+};
+
+char const *const optionString = "abcdo:";
+
+std::vector<std::string> const &longOptionNames() {
+  static std::vector<std::string> names = [] {
+    std::vector<std::string> n{};
+    for (std::size_t i = 0; i < 64; ++i)
+      n.push_back("long-option-" + std::to_string(i));
+    return n;
+  }();
+  return names;
+}
+
+std::vector<option> const &longOptions() {
+  static std::vector<option> options = [] {
+    std::vector<option> o{};
+    for (std::size_t i = 0; i < longOptionNames().size(); ++i)
+      o.push_back({longOptionNames()[i].c_str(),
+                   i % 2 ? required_argument : no_argument, nullptr,
+                   int(256 + i)});
+    o.push_back({nullptr, 0, nullptr, 0});
+    return o;
+  }();
+  return options;
+}
+
+CaseT makeCase(std::string const &shape, std::size_t const argc) {
+  CaseT c{shape, {"program"}};
+  auto const &names = longOptionNames();
+  for (std::size_t i = 0; c.arguments.size() < argc; ++i) {
+    std::string const &name = names[(i * 7) % names.size()];
+    bool const takesValue = (i * 7) % names.size() % 2;
+
+    if (shape == "shortClusters") {
+      c.arguments.push_back(i % 2 ? "-abc" : "-dovalue");
+    } else if (shape == "longOptions") {
+      c.arguments.push_back("--" + name + (takesValue ? "=value" : ""));
+    } else {
+      c.arguments.push_back("file" + std::to_string(i));
+      c.arguments.push_back("--" + name + (takesValue ? "=value" : ""));
+    }
+  }
+  return c;
+}
+
+MeasurementT measure(double const minNs, GetoptT const getopt, int *const index,
+                     CaseT const &c) {
+  std::vector<std::string> arguments = c.arguments;
+  std::vector<char *> original{}, argv{};
+  for (auto &argument : arguments)
+    original.push_back(argument.data());
+  int const argc = original.size();
+
+  MeasurementT m{};
+  while (m.totalNs < minNs) {
+    argv = original;
+    argv.push_back(nullptr);
+    *index = 0;
+    m.checksum = 0;
+
+    auto const start = clock_t::now();
+    for (int r; (r = getopt(argc, argv.data(), optionString,
+                            longOptions().data(), nullptr)) != -1;)
+      m.checksum = m.checksum * 31 + r;
+    m.checksum = m.checksum * 31 + *index;
+    auto const d = clock_t::now() - start;
+
+    m.totalNs += std::chrono::duration<double, std::nano>(d).count();
+    ++m.iterations;
+  }
+  return m;
+}
+
+void printResult(CaseT const &c, MeasurementT const &libc,
+                 MeasurementT const &ap, bool const last) {
+  double const libcNs = libc.totalNs / libc.iterations;
+  double const apNs = ap.totalNs / ap.iterations;
+
+  std::cout << "    {\"name\": \"" << c.shape << "\", ";
+  std::cout << "\"argc\": " << c.arguments.size() << ", ";
+  std::cout << "\"libcNsPerIteration\": " << libcNs << ", ";
+  std::cout << "\"apNsPerIteration\": " << apNs << ", ";
+  std::cout << "\"apNsPerArgument\": " << apNs / c.arguments.size() << ", ";
+  std::cout << "\"speedup\": " << libcNs / apNs << ", ";
+  std::cout << "\"result\": \""
+            << (libc.checksum == ap.checksum ? "Success" : "Mismatch")
+            << "\"}" << (last ? "\n" : ",\n");
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc > 2) {
+    std::cerr << "Too many arguments; Usage: [minMillisPerCase]\n";
+    return 1;
+  }
+
+  double const minNs = (argc == 2 ? std::stod(argv[1]) : 100.0) * 1e6;
+  std::vector<CaseT> cases{};
+  for (std::string const shape : {"shortClusters", "longOptions", "interleaved"})
+    for (std::size_t const count : {16, 1024, 16384})
+      cases.push_back(makeCase(shape, count));
+
+  opterr = 0;
+  ap_opterr = 0;
+  int status = 0;
+  std::cout << "{\n  \"benchmark\": \"getoptLong\",\n  \"results\": [\n";
+
+  for (std::size_t i = 0; i < cases.size(); ++i) {
+    auto const libc = measure(minNs, getopt_long, &optind, cases[i]);
+    auto const ap = measure(minNs, ap_getopt_long, &ap_optind, cases[i]);
+    if (libc.checksum != ap.checksum)
+      status = 1;
+    printResult(cases[i], libc, ap, i + 1 == cases.size());
+  }
+
+  std::cout << "  ]\n}" << std::endl;
+  return status;
+}
@@ -0,0 +1,2 @@
+add_executable(ringLogReader ringLogReader.cpp)
+target_link_libraries(ringLogReader scopedLogger)
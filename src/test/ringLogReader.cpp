@@ -0,0 +1,59 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * A reader for files written by the RingFile output mode. The entries
+ * still held by the file are written to the standard output, oldest
+ * first, and the number of times the buffer wrapped around to the
+ * standard error. The file may be read while a logger is writing it,
+ * or after the process writing it has crashed.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The entries were read.
+ *
+ * 1 - The file couldn't be read, or isn't a valid ring file.
+ */
+
+#include <badline/scopedLogger.hpp>
+#include <iostream>
+
+int main(int const argc, char const *const *const argv) {
+  if (argc != 2) {
+    std::cerr << "Wrong argument count; Usage: <file>\n";
+    return 1;
+  }
+
+  std::vector<std::string> entries{};
+  std::size_t wraps{};
+  if (auto r = sl::readRingLogFile(argv[1], &entries, &wraps);
+      r != sl::Result::Success) {
+    std::cerr << "Failed to read the ring file: " << r << std::endl;
+    return 1;
+  }
+
+  for (auto const &entry : entries)
+    std::cout << entry;
+  std::cout.flush();
+  std::cerr << entries.size() << " entries, " << wraps << " wraps"
+            << std::endl;
+  return 0;
+}
@@ -0,0 +1,2 @@
+add_executable(scopedLoggerBench scopedLoggerBench.cpp)
+target_link_libraries(scopedLoggerBench scopedLogger)
@@ -0,0 +1,221 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary measures the latency of logging calls. It takes one optional
+ * parameter, which is the number of messages logged by every case
+ * (100000 by default).
+ *
+ * Every call is timed separately, and the percentiles of the latency are
+ * reported. The synchronous cases write and flush every entry on the
+ * calling thread, while the asynchronous ones only push it into the queue
+ * of the writer thread, whose occupancy and drop count are reported too.
+ * The burst cases log as fast as possible, while the paced ones pause
+ * between the calls. The console output is discarded, and the timing
+ * includes the overhead of reading the clock. The file cases write to
+ * a temporary file with the default flush policy instead of the console,
+ * and the binary ones write the message and a counter through a call site
+ * macro, into a binary log. The disabled cases log below the level of
+ * the logger, building the message by concatenation through 'inf', or
+ * passing its parts to the macro, which skips their evaluation. The
+ * suppressed cases log the same message over and over, folded into the
+ * first one, or limited to 1000 entries a second. The throughput of every
+ * case is reported, including the final flush.
+ *
+ * The results are printed to the standard output as a single JSON
+ * document, so that runs of different revisions can be compared.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - All the cases ran.
+ *
+ * 1 - Invalid usage, or a logger couldn't be created.
+ */
+
+#include <badline/scopedLogger.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+
+namespace {
+using clock_t = std::chrono::steady_clock;
+
+class NullBuffer : public std::streambuf {
+protected:
+  int overflow(int const c) override { return c; }
+  std::streamsize xsputn(char const *, std::streamsize const n) override {
+    return n;
+  }
+};
+
+struct CaseT {
+  std::string name{};
+  bool async{};
+  std::size_t queueSize{};
+  std::size_t messageLength{};
+  std::chrono::nanoseconds pause{};
+  bool file{};
+  bool binary{};
+  bool disabled{};
+  bool fold{};
+  std::size_t rateLimit{};
+};
+
+struct MeasurementT {
+  std::vector<double> latencies{};
+  sl::LogQueueStats stats{};
+  std::size_t failures{};
+  double messagesPerSecond{};
+};
+
+int runCase(CaseT const &c, std::size_t const count, MeasurementT *const m) {
+  sl::LoggerT *logger{};
+  if (auto r = sl::createLogger(&logger, "bench"); r != sl::Result::Success)
+    return r;
+
+  auto const path = (std::filesystem::temp_directory_path() /
+                     "scopedLoggerBench.log")
+                        .string();
+  if (c.file || c.binary) {
+    std::filesystem::remove(path);
+    sl::outputToConsole(logger, false);
+    sl::outputToFile(logger, c.file);
+    sl::outputToBinaryFile(logger, c.binary);
+    auto const r = c.file ? sl::setLogFile(logger, path)
+                          : sl::setBinaryLogFile(logger, path);
+    if (r != sl::Result::Success) {
+      sl::destroyLogger(logger);
+      return r;
+    }
+  }
+
+  sl::logLevelInf(logger, !c.disabled);
+  sl::foldDuplicates(logger, c.fold);
+  sl::setRateLimit(logger, c.rateLimit, 10);
+  sl::resizeLogQueue(logger, c.queueSize);
+  sl::writeAsync(logger, c.async);
+  std::string const message(c.messageLength, 'm');
+  m->latencies.reserve(count);
+
+  auto const begin = clock_t::now();
+  for (std::size_t i = 0; i < count; ++i) {
+    auto const start = clock_t::now();
+    int r = sl::Result::Success;
+    if (c.binary)
+      SL_INF(logger, "{} {}", message, i);
+    else if (c.disabled)
+      r = sl::inf(logger, message + " " + std::to_string(i));
+    else
+      r = sl::inf(logger, message);
+    auto const d = clock_t::now() - start;
+    m->latencies.push_back(std::chrono::duration<double, std::nano>(d).count());
+    m->failures += r != sl::Result::Success;
+
+    // A paced case leaves the writer time to keep up, like a frame loop
+    // logging a few lines per frame.
+    for (auto const end = clock_t::now() + c.pause; clock_t::now() < end;)
+      ;
+  }
+
+  sl::getLogQueueStats(logger, &m->stats);
+  sl::flushLogQueue(logger);
+  if (c.file)
+    sl::flushLogFile(logger);
+  if (c.binary)
+    sl::flushBinaryLog(logger);
+  std::chrono::duration<double> const total = clock_t::now() - begin;
+  m->messagesPerSecond = count / total.count();
+  sl::destroyLogger(logger);
+  if (c.file || c.binary)
+    std::filesystem::remove(path);
+  return sl::Result::Success;
+}
+
+double percentile(std::vector<double> const &sorted, double const p) {
+  return sorted[std::min(sorted.size() - 1, std::size_t(p * sorted.size()))];
+}
+
+void printResult(std::ostream &s, CaseT const &c, MeasurementT &m,
+                 bool const last) {
+  std::sort(m.latencies.begin(), m.latencies.end());
+  s << "    {\"name\": \"" << c.name << "\", ";
+  s << "\"messageLength\": " << c.messageLength << ", ";
+  s << "\"calls\": " << m.latencies.size() << ", ";
+  s << "\"p50Ns\": " << percentile(m.latencies, 0.5) << ", ";
+  s << "\"p99Ns\": " << percentile(m.latencies, 0.99) << ", ";
+  s << "\"p999Ns\": " << percentile(m.latencies, 0.999) << ", ";
+  s << "\"maxNs\": " << m.latencies.back() << ", ";
+  s << "\"messagesPerSecond\": " << m.messagesPerSecond << ", ";
+  s << "\"queueCapacity\": " << m.stats.capacity << ", ";
+  s << "\"peakOccupancy\": " << m.stats.peakOccupancy << ", ";
+  s << "\"dropped\": " << m.failures << "}" << (last ? "\n" : ",\n");
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc > 2) {
+    std::cerr << "Too many arguments; Usage: [messagesPerCase]\n";
+    return 1;
+  }
+
+  std::size_t const count = argc == 2 ? std::stoul(argv[1]) : 100000;
+  std::vector<CaseT> const cases{
+      {"sync", false, 1024, 32},
+      {"sync", false, 1024, 256},
+      {"syncFile", false, 1024, 32, {}, true},
+      {"syncFile", false, 1024, 256, {}, true},
+      {"syncBinary", false, 1024, 32, {}, false, true},
+      {"syncBinary", false, 1024, 256, {}, false, true},
+      {"disabledInf", false, 1024, 256, {}, false, false, true},
+      {"disabledMacro", false, 1024, 256, {}, false, true, true},
+      {"folded", false, 1024, 256, {}, false, false, false, true},
+      {"rateLimited", false, 1024, 256, {}, false, false, false, false, 1000},
+      {"asyncBurst", true, 1 << 17, 32},
+      {"asyncBurst", true, 1 << 17, 256},
+      {"asyncBurstFile", true, 1 << 17, 32, {}, true},
+      {"asyncBurstSmallQueue", true, 1024, 32},
+      {"asyncPaced", true, 1024, 32, std::chrono::microseconds{5}},
+      {"asyncPaced", true, 1024, 256, std::chrono::microseconds{5}}};
+
+  // The JSON document goes to the original output, and the log to a sink.
+  NullBuffer sink{};
+  std::ostream json{std::cout.rdbuf(&sink)};
+  auto *const errors = std::cerr.rdbuf(&sink);
+
+  json << "{\n  \"benchmark\": \"scopedLogger\",\n  \"results\": [\n";
+  int status = 0;
+  for (std::size_t i = 0; i < cases.size(); ++i) {
+    MeasurementT m{};
+    if (runCase(cases[i], count, &m) != sl::Result::Success) {
+      status = 1;
+      continue;
+    }
+    printResult(json, cases[i], m, i + 1 == cases.size());
+  }
+  json << "  ]\n}" << std::endl;
+
+  std::cout.rdbuf(json.rdbuf());
+  std::cerr.rdbuf(errors);
+  return status;
+}
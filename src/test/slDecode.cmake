@@ -0,0 +1,2 @@
+add_executable(slDecode slDecode.cpp)
+target_link_libraries(slDecode scopedLogger)
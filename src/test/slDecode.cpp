@@ -0,0 +1,56 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * A decoder for files written by the BinaryFile output mode. The entries
+ * are formatted the way the logger would have written them to a text
+ * file, and written to the standard output. An entry cut short at the end
+ * of the file, as the last one written by a process which crashed, ends
+ * the log.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The entries were decoded.
+ *
+ * 1 - The file couldn't be read, or isn't a valid binary log.
+ */
+
+#include <badline/scopedLogger.hpp>
+#include <iostream>
+
+int main(int const argc, char const *const *const argv) {
+  if (argc != 2) {
+    std::cerr << "Wrong argument count; Usage: <file>\n";
+    return 1;
+  }
+
+  std::vector<std::string> entries{};
+  if (auto r = sl::decodeBinaryLog(argv[1], &entries);
+      r != sl::Result::Success) {
+    std::cerr << "Failed to decode the binary log: " << r << std::endl;
+    return 1;
+  }
+
+  for (auto const &entry : entries)
+    std::cout << entry;
+  std::cout.flush();
+  return 0;
+}
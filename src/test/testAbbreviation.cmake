@@ -0,0 +1,25 @@
+add_executable(testAbbreviation testAbbreviation.cpp)
+target_link_libraries(testAbbreviation argParser)
+
+add_test(NAME abbreviationTest0001 COMMAND testAbbreviation on "--verb" "verbose")
+add_test(NAME abbreviationTest0002 COMMAND testAbbreviation on "--versi" "version")
+add_test(NAME abbreviationTest0003 COMMAND testAbbreviation on "--veri" "verify")
+add_test(NAME abbreviationTest0004 COMMAND testAbbreviation on "--he" "help")
+add_test(NAME abbreviationTest0005 COMMAND testAbbreviation on "--lev" "level")
+add_test(NAME abbreviationTest0006 COMMAND testAbbreviation on "--ver" "ambiguous:")
+add_test(NAME abbreviationTest0007 COMMAND testAbbreviation on "--ve" "ambiguous:")
+add_test(NAME abbreviationTest0008 COMMAND testAbbreviation on "--out" "out")
+add_test(NAME abbreviationTest0009 COMMAND testAbbreviation on "--outp" "output")
+add_test(NAME abbreviationTest0010 COMMAND testAbbreviation on "--ou" "ambiguous:out")
+add_test(NAME abbreviationTest0011 COMMAND testAbbreviation on "--verbose" "verbose")
+add_test(NAME abbreviationTest0012 COMMAND testAbbreviation off "--verbos" "invalid:verbose")
+add_test(NAME abbreviationTest0013 COMMAND testAbbreviation off "--out" "out")
+add_test(NAME abbreviationTest0014 COMMAND testAbbreviation on "--lvel" "invalid:level")
+add_test(NAME abbreviationTest0015 COMMAND testAbbreviation on "--verifx" "invalid:verify")
+add_test(NAME abbreviationTest0016 COMMAND testAbbreviation on "--versoin" "invalid:version")
+add_test(NAME abbreviationTest0017 COMMAND testAbbreviation on "--verbsoe" "invalid:verbose")
+add_test(NAME abbreviationTest0018 COMMAND testAbbreviation on "--outptu" "invalid:output")
+add_test(NAME abbreviationTest0019 COMMAND testAbbreviation on "--xyzzy" "invalid:")
+add_test(NAME abbreviationTest0020 COMMAND testAbbreviation on "--helpme" "invalid:help")
+add_test(NAME abbreviationTest0021 COMMAND testAbbreviation off "--outpt" "invalid:output")
+add_test(NAME abbreviationTest0022 COMMAND testAbbreviation off "--oux" "invalid:out")
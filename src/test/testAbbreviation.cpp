@@ -0,0 +1,115 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary tests abbreviated long forms and the suggestions offered
+ * for unknown ones. The first parameter is either 'on' or 'off', telling
+ * whether abbreviations are allowed, the second one is a token, and
+ * the third one is the expected result.
+ *
+ * The flags 'verbose', 'version', 'verify' and 'help', and the options
+ * 'output', 'out' and 'level' are registered. When the token is expected
+ * to be accepted, the result is the long form which receives it. When it
+ * is expected to be rejected, the result is 'invalid:<suggestion>' or
+ * 'ambiguous:<suggestion>', where the suggestion may be empty. An accepted
+ * token must leave no suggestion behind. The token follows a free value,
+ * and the error position must point at it only when it is rejected.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The token was resolved as expected.
+ *
+ * 1 - The result doesn't match the expectations.
+ */
+
+#include <badline/argParser.hpp>
+#include <iostream>
+
+namespace {
+int createSpec(ap::ArgParserT **const handle) {
+  if (auto r = ap::createArgParser(handle); r != ap::Result::Success)
+    return r;
+
+  ap::ArgParserT *const h = *handle;
+  for (auto r : {ap::addFlag(h, "verbose"), ap::addFlag(h, "version"),
+                 ap::addFlag(h, "verify"), ap::addFlag(h, "help"),
+                 ap::addOption(h, "output"), ap::addOption(h, "out"),
+                 ap::addOption(h, "level")})
+    if (r != ap::Result::Success)
+      return r;
+  return ap::Result::Success;
+}
+
+std::string receiver(ap::ArgParserT const *const handle) {
+  for (std::string const name : {"verbose", "version", "verify", "help"}) {
+    std::size_t count{};
+    if (ap::getFlagCount(handle, name, &count) == ap::Result::Success &&
+        count)
+      return name;
+  }
+  for (std::string const name : {"output", "out", "level"}) {
+    std::size_t count{};
+    if (ap::getOptionCount(handle, name, &count) == ap::Result::Success &&
+        count)
+      return name;
+  }
+  return {};
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc != 4) {
+    std::cerr << "Wrong argument count; Usage: <on|off> <token> <expected>\n";
+    return 1;
+  }
+
+  std::string const expected = argv[3];
+  ap::ArgParserT *handle{};
+  if (createSpec(&handle) != ap::Result::Success)
+    return 1;
+  ap::allowLongFormAbbreviations(handle, std::string{argv[1]} == "on");
+
+  char const *const input[] = {"free", argv[2], "value"};
+  int const r = ap::parse(handle, input, 0, 3);
+
+  std::string suggestion{}, result{};
+  std::size_t position{};
+  ap::getLongFormSuggestion(handle, &suggestion);
+  ap::getErrorPosition(handle, &position);
+  if (r == ap::Result::Success)
+    result = suggestion.empty() ? receiver(handle) : "stale:" + suggestion;
+  else if (r == ap::Result::ErrorArgLongFormAmbiguous)
+    result = "ambiguous:" + suggestion;
+  else if (r == ap::Result::ErrorArgLongFormNotValid)
+    result = "invalid:" + suggestion;
+  else
+    ap::Result::toString(r, &result);
+
+  std::cout << "token: " << argv[2] << std::endl;
+  std::cout << "result: " << result << std::endl;
+  std::cout << "error position: " << position << std::endl;
+
+  ap::destroyArgParser(handle);
+  return result == expected &&
+                 position == (r == ap::Result::Success ? 0u : 1u)
+             ? 0
+             : 1;
+}
@@ -0,0 +1,5 @@
+add_executable(testBinaryLog testBinaryLog.cpp)
+target_link_libraries(testBinaryLog scopedLogger)
+
+add_test(NAME binaryLogTest0001 COMMAND testBinaryLog binary)
+add_test(NAME binaryLogTest0002 COMMAND testBinaryLog text)
@@ -0,0 +1,185 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary tests the call site logging macros. The parameter is the
+ * output mode: binary, in which the entries are written to a binary log
+ * and decoded with 'decodeBinaryLog', or text, in which they're formatted
+ * on the spot and written to a text file.
+ *
+ * Both modes must produce the same entries, with the arguments of every
+ * type substituted for their placeholders, escaped braces, a disabled
+ * level skipped, and an argument too long to pack cut short. The entries
+ * are named after their scope rather than their function, and follow the
+ * one-time properties until an entry is written with them. The binary log
+ * is set after the same entries went to another one, and must define their
+ * call sites and scopes again. A binary log cut in the middle of its last
+ * entry must decode to the entries before, and one cut anywhere in its
+ * last records to a prefix of them.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The entries match the expected ones.
+ *
+ * 1 - The entries don't match the expected ones, or couldn't be written.
+ */
+
+#include <badline/scopedLogger.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+std::string const longArgument(1000, 'l');
+
+void emit(sl::LoggerT *const logger) {
+  sl::FunctionScope const scope{logger, "outer"};
+  SL_INF(logger, "plain");
+  SL_INF(logger, "ints {} {} {}", 42, -7, std::uint64_t(-1));
+  SL_WRN(logger, "mixed {} {} {} {}", 2.5, true, 'x', std::string{"text"});
+  SL_ERR(logger, "braces {{}} {}", "literal");
+  for (int i = 0; i < 3; ++i)
+    SL_INF(logger, "loop {}", i);
+  sl::logLevelInf(logger, false);
+  SL_INF(logger, "hidden {}", 1);
+  sl::logLevelInf(logger, true);
+  SL_INF(logger, "long {}", longArgument);
+  {
+    sl::FunctionScope const inner{logger, "inner"};
+    SL_INF(logger, "nested {}", 1);
+  }
+  sl::oneTimeLogLevelInf(logger, false);
+  SL_INF(logger, "hidden once {}", 2);
+  SL_WRN(logger, "warned {}", 3);
+  SL_INF(logger, "shown {}", 4);
+  sl::oneTimePrefixLevel(logger, false);
+  SL_INF(logger, "unprefixed {}", 5);
+  SL_INF(logger, "prefixed {}", 6);
+  sl::FunctionScope const last{logger, "last"};
+  SL_WRN(logger, "last {}", 7);
+}
+
+std::vector<std::string> expectedEntries() {
+  // The type tag and length of the string take five of the packed bytes.
+  std::size_t const longLength = sl::detail::maxPackedArgsSize - 5;
+  return {"[Info] outer: plain\n",
+          "[Info] outer: ints 42 -7 18446744073709551615\n",
+          "[Warning] outer: mixed 2.5 true x text\n",
+          "[Error] outer: braces {} literal\n",
+          "[Info] outer: loop 0\n",
+          "[Info] outer: loop 1\n",
+          "[Info] outer: loop 2\n",
+          "[Info] outer: long " + longArgument.substr(0, longLength) + "\n",
+          "[Info] inner: nested 1\n",
+          "[Warning] outer: warned 3\n",
+          "[Info] outer: shown 4\n",
+          "outer: unprefixed 5\n",
+          "[Info] outer: prefixed 6\n",
+          "[Warning] last: last 7\n"};
+}
+
+std::vector<std::string> readLines(std::string const &path) {
+  std::vector<std::string> lines{};
+  std::ifstream file{path};
+  for (std::string line{}; std::getline(file, line);)
+    lines.push_back(line + "\n");
+  return lines;
+}
+
+bool matches(std::vector<std::string> const &entries,
+             std::vector<std::string> const &expected) {
+  for (auto const &entry : entries)
+    std::cout << entry;
+  return entries == expected;
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc != 2) {
+    std::cerr << "Wrong argument count; Usage: <binary|text>\n";
+    return 1;
+  }
+
+  bool const binary = std::string{argv[1]} == "binary";
+  auto const path = (std::filesystem::temp_directory_path() /
+                     ("testBinaryLog-" + std::to_string(::getpid()) + ".log"))
+                        .string();
+
+  sl::LoggerT *logger{};
+  if (sl::createLogger(&logger, "test") != sl::Result::Success)
+    return 1;
+
+  bool success = sl::outputToConsole(logger, false) == sl::Result::Success &&
+                 sl::prefixTime(logger, false) == sl::Result::Success;
+  if (binary) {
+    success = success &&
+              sl::outputToBinaryFile(logger, true) == sl::Result::Success &&
+              sl::setBinaryLogFile(logger, path + ".first") ==
+                  sl::Result::Success;
+    if (success)
+      emit(logger);
+    success = success &&
+              sl::setBinaryLogFile(logger, path) == sl::Result::Success;
+    std::filesystem::remove(path + ".first");
+  } else
+    success = success &&
+              sl::outputToFile(logger, true) == sl::Result::Success &&
+              sl::setLogFile(logger, path) == sl::Result::Success;
+
+  if (success)
+    emit(logger);
+  success = success && (binary ? sl::flushBinaryLog(logger)
+                               : sl::flushLogFile(logger)) ==
+                           sl::Result::Success;
+  sl::destroyLogger(logger);
+
+  auto const expected = expectedEntries();
+  std::vector<std::string> entries{};
+  if (binary)
+    success = success &&
+              sl::decodeBinaryLog(path, &entries) == sl::Result::Success;
+  else
+    entries = readLines(path);
+  success = success && matches(entries, expected);
+
+  if (success && binary) {
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+    success = sl::decodeBinaryLog(path, &entries) == sl::Result::Success &&
+              entries.size() + 1 == expected.size() &&
+              std::equal(entries.begin(), entries.end(), expected.begin());
+  }
+
+  // The last entries, and the definitions of their call sites and scopes,
+  // cut at every byte.
+  for (std::size_t i = 0; success && binary && i < 100; ++i) {
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    success = sl::decodeBinaryLog(path, &entries) == sl::Result::Success &&
+              entries.size() < expected.size() &&
+              std::equal(entries.begin(), entries.end(), expected.begin());
+  }
+
+  std::filesystem::remove(path);
+  return success ? 0 : 1;
+}
@@ -0,0 +1,43 @@
+add_executable(testClassifier testClassifier.cpp)
+target_link_libraries(testClassifier argParser)
+
+add_test(NAME classifierTest0001 COMMAND testClassifier validate "--value=caf\\xC3\\xA9" accept)
+add_test(NAME classifierTest0002 COMMAND testClassifier validate "--value=aaaaaaa\\xC3\\xA9" accept)
+add_test(NAME classifierTest0003 COMMAND testClassifier validate "--value=aaaaaa\\xE2\\x82\\xAC" accept)
+add_test(NAME classifierTest0004 COMMAND testClassifier validate "--value=aaaaaaaaaaaaaaaaaaaaaaa\\xC3\\xA9" accept)
+add_test(NAME classifierTest0005 COMMAND testClassifier validate "--value=aaaaaaaaaaaaaaaaaaaaaa\\xE2\\x82\\xAC" accept)
+add_test(NAME classifierTest0006 COMMAND testClassifier validate "--value=aaaaaaaaaaaaaaaaaaaaa\\xF0\\x9F\\x98\\x80" accept)
+add_test(NAME classifierTest0007 COMMAND testClassifier validate "--value=aaaaa\\xF0\\x9F\\x98\\x80aaaaaaaaaaaaaaaaaaaa\\xF4\\x8F\\xBF\\xBF" accept)
+add_test(NAME classifierTest0008 COMMAND testClassifier validate "\\xED\\x9F\\xBF\\xEE\\x80\\x80" accept)
+add_test(NAME classifierTest0009 COMMAND testClassifier validate "--value=\\xC0\\xAF" reject)
+add_test(NAME classifierTest0010 COMMAND testClassifier validate "--value=\\xC1\\xBF" reject)
+add_test(NAME classifierTest0011 COMMAND testClassifier validate "--value=\\xE0\\x80\\xAF" reject)
+add_test(NAME classifierTest0012 COMMAND testClassifier validate "--value=\\xF0\\x80\\x80\\xAF" reject)
+add_test(NAME classifierTest0013 COMMAND testClassifier validate "--value=\\xED\\xA0\\x80" reject)
+add_test(NAME classifierTest0014 COMMAND testClassifier validate "--value=\\xED\\xBF\\xBF" reject)
+add_test(NAME classifierTest0015 COMMAND testClassifier validate "--value=\\xF4\\x90\\x80\\x80" reject)
+add_test(NAME classifierTest0016 COMMAND testClassifier validate "--value=\\xF5\\x80\\x80\\x80" reject)
+add_test(NAME classifierTest0017 COMMAND testClassifier validate "--value=\\xFF" reject)
+add_test(NAME classifierTest0018 COMMAND testClassifier validate "--value=\\x80abc" reject)
+add_test(NAME classifierTest0019 COMMAND testClassifier validate "--value=ab\\xC3\\xA9\\xA9" reject)
+add_test(NAME classifierTest0020 COMMAND testClassifier validate "--value=aaaaaaa\\xC3" reject)
+add_test(NAME classifierTest0021 COMMAND testClassifier validate "--value=aaaaaa\\xE2\\x82" reject)
+add_test(NAME classifierTest0022 COMMAND testClassifier validate "--value=aaaaaaaaaaaaaaaaaaaaaaa\\xC3" reject)
+add_test(NAME classifierTest0023 COMMAND testClassifier validate "--value=aaaaaaaaaaaaaaaaaaaaa\\xF0\\x9F\\x98" reject)
+add_test(NAME classifierTest0024 COMMAND testClassifier validate "--value=aaaaaaa\\xC3aaaaaaaaaaaaaaaaaaaa" reject)
+add_test(NAME classifierTest0025 COMMAND testClassifier validate "--value=aaaaaaaaaaaaaaaaaaaaa\\xF0\\x9F\\x98aaaaaaaaa" reject)
+add_test(NAME classifierTest0026 COMMAND testClassifier validate "--value= x" reject)
+add_test(NAME classifierTest0027 COMMAND testClassifier validate "--value=\\x7F" reject)
+add_test(NAME classifierTest0028 COMMAND testClassifier classify "--verbose" fast)
+add_test(NAME classifierTest0029 COMMAND testClassifier classify "-v" fast)
+add_test(NAME classifierTest0030 COMMAND testClassifier classify "-abc" fast)
+add_test(NAME classifierTest0031 COMMAND testClassifier classify "value" fast)
+add_test(NAME classifierTest0032 COMMAND testClassifier classify "/tmp/file" fast)
+add_test(NAME classifierTest0033 COMMAND testClassifier classify "caf\\xC3\\xA9" fast)
+add_test(NAME classifierTest0034 COMMAND testClassifier classify "\\xC3\\xA9t\\xC3\\xA9" fast)
+add_test(NAME classifierTest0035 COMMAND testClassifier classify "\\xF0\\x9F\\x98\\x80\\xF4\\x8F\\xBF\\xBF" fast)
+add_test(NAME classifierTest0036 COMMAND testClassifier classify "--dry-run" grammar)
+add_test(NAME classifierTest0037 COMMAND testClassifier classify "--level=high" grammar)
+add_test(NAME classifierTest0038 COMMAND testClassifier classify "-l=caf\\xC3\\xA9" grammar)
+add_test(NAME classifierTest0039 COMMAND testClassifier classify "--caf\\xC3\\xA9" grammar)
+add_test(NAME classifierTest0040 COMMAND testClassifier bytes)
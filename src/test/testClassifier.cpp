@@ -0,0 +1,144 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary tests the 'validateToken' and 'classifyToken' methods.
+ * The first parameter is the mode, the second one is a token, in which
+ * '\xHH' stands for the byte HH, and the third one is the expected result.
+ *
+ * In the 'validate' mode the result is either 'accept' or 'reject',
+ * telling whether the token is expected to be valid UTF-8 made of
+ * printable characters.
+ *
+ * In the 'classify' mode the result is either 'fast', when the token is
+ * expected to be classified without the grammar, or 'grammar' otherwise.
+ * A token classified without the grammar must be derived by the grammar
+ * into the same name, value and kind.
+ *
+ * The 'bytes' mode takes no further parameters, and checks that every
+ * byte above 127 is a terminal of both Printable and NonShortArgPrefix.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The token was validated or classified as expected.
+ *
+ * 1 - The result doesn't match the expectations.
+ */
+
+#include <argParser/internals.hpp>
+#include <iostream>
+
+namespace {
+std::string decode(std::string const &input) {
+  std::string output{};
+  for (std::size_t i = 0; i < input.size(); ++i) {
+    if (input.compare(i, 2, "\\x") == 0 && i + 4 <= input.size()) {
+      output += char(std::stoi(input.substr(i + 2, 2), nullptr, 16));
+      i += 3;
+    } else
+      output += input[i];
+  }
+  return output;
+}
+
+void print(std::string const &label, ap::TokenInfoT const &info) {
+  std::cout << label << ": name '" << info.argName << "', value '"
+            << info.argVal << "', list " << info.isArgList << ", free "
+            << info.isFreeVal << std::endl;
+}
+
+bool checkBytes() {
+  using R = ap::GrammarRuleT::Identifier;
+  ap::ParsingDatabaseT database{};
+  ap::fillParsingDatabase(&database);
+
+  for (std::size_t c = 128; c < 256; ++c) {
+    auto const &nterms = database.termTable[c];
+    if (nterms.size() != 2 || nterms[0] != R::Printable ||
+        nterms[1] != R::NonShortArgPrefix) {
+      std::cout << "byte " << c << " has " << nterms.size() << " terminals"
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool classify(std::string const &token, std::string const &expected) {
+  bool ascii{};
+  if (ap::validateToken(token, &ascii) != ap::Result::Success)
+    return false;
+
+  ap::ParsingDatabaseT fast{}, grammar{};
+  ap::fillParsingDatabase(&fast);
+  ap::fillParsingDatabase(&grammar);
+
+  bool const classified = ap::classifyToken(&fast, &token, ascii);
+  bool const derived =
+      ap::parseCYK(&grammar, &token) == ap::Result::Success &&
+      ap::tracePostorderPath(&grammar, 0) == ap::Result::Success &&
+      ap::applySemanticActions(&grammar, &token) == ap::Result::Success;
+
+  std::cout << "classified: " << (classified ? "fast" : "grammar")
+            << std::endl;
+  if (classified)
+    print("fast", fast.tokenInfo);
+  if (derived)
+    print("grammar", grammar.tokenInfo);
+
+  if (classified != (expected == "fast"))
+    return false;
+  if (!classified)
+    return true;
+
+  auto const &a = fast.tokenInfo;
+  auto const &b = grammar.tokenInfo;
+  return derived && a.argName == b.argName && a.argVal == b.argVal &&
+         a.isArgList == b.isArgList && a.isFreeVal == b.isFreeVal;
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc == 2 && std::string{argv[1]} == "bytes")
+    return checkBytes() ? 0 : 1;
+
+  if (argc != 4) {
+    std::cerr << "Wrong argument count; Usage: <mode> <token> <expected>\n";
+    return 1;
+  }
+
+  std::string const mode = argv[1];
+  std::string const token = decode(argv[2]);
+  std::string const expected = argv[3];
+  std::cout << "token: " << argv[2] << " (" << token.size() << " bytes)"
+            << std::endl;
+
+  if (mode == "classify")
+    return classify(token, expected) ? 0 : 1;
+
+  bool ascii{};
+  int const r = ap::validateToken(token, &ascii);
+  std::cout << "valid: " << (r == ap::Result::Success) << ", ascii: " << ascii
+            << std::endl;
+  if (mode != "validate")
+    return 1;
+  return (r == ap::Result::Success) == (expected == "accept") ? 0 : 1;
+}
@@ -0,0 +1,16 @@
+add_executable(testCompletion testCompletion.cpp)
+target_link_libraries(testCompletion argParser)
+
+add_test(NAME completionTest0001 COMMAND testCompletion "--ver" "--verbose" "--version")
+add_test(NAME completionTest0002 COMMAND testCompletion "--o" "--output")
+add_test(NAME completionTest0003 COMMAND testCompletion "--" "--level" "--output" "--verbose" "--version")
+add_test(NAME completionTest0004 COMMAND testCompletion "--level " "debug" "info" "warn")
+add_test(NAME completionTest0005 COMMAND testCompletion "-v -l i" "info")
+add_test(NAME completionTest0006 COMMAND testCompletion "--level=d" "--level=debug")
+add_test(NAME completionTest0007 COMMAND testCompletion "-" "-l" "-o" "-v")
+add_test(NAME completionTest0008 COMMAND testCompletion "b" "bench" "broken" "build")
+add_test(NAME completionTest0009 COMMAND testCompletion "build --" "--jobs" "--release")
+add_test(NAME completionTest0010 COMMAND testCompletion "--output -- --l")
+add_test(NAME completionTest0011 COMMAND testCompletion "--x")
+add_test(NAME completionTest0012 COMMAND testCompletion "--level \"i\"" "info")
+add_test(NAME completionTest0013 COMMAND testCompletion "--level de\\ ")
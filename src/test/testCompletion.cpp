@@ -0,0 +1,144 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary tests the 'complete' method. The first parameter is
+ * a command line, and the remaining parameters are the candidates
+ * expected for its last token, or for a new token if the command line
+ * ends with a blank outside of quotes and escapes.
+ *
+ * The flags 'verbose' (v) and 'version', the options 'output' (o) and
+ * 'level' (l), whose values are 'debug', 'info' and 'warn', and
+ * the subcommands 'build', 'bench' and 'broken' are registered.
+ * The subcommands 'build' and 'bench' have the flag 'release' and
+ * the option 'jobs' (j), while the spec of 'broken' fails.
+ *
+ * The last token is also completed one character at a time, the way
+ * it is typed, after a query failing in the spec of 'broken', and
+ * the final candidates must match.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The candidates match the expectations.
+ *
+ * 1 - The query was rejected, or the candidates don't match.
+ */
+
+#include <argParser/internals.hpp>
+#include <iostream>
+
+namespace {
+int createSpec(ap::ArgParserT **const handle) {
+  if (auto r = ap::createArgParser(handle); r != ap::Result::Success)
+    return r;
+
+  auto const buildSpec = [](ap::ArgParserT *const build) {
+    if (auto r = ap::addFlag(build, "release"); r != ap::Result::Success)
+      return r;
+    return ap::addOption(build, "jobs", 'j');
+  };
+  auto const brokenSpec = [](ap::ArgParserT *const) {
+    return int(ap::Result::ErrorArgLongFormNotValid);
+  };
+
+  ap::ArgParserT *const h = *handle;
+  for (auto r : {ap::addFlag(h, "verbose", 'v'), ap::addFlag(h, "version"),
+                 ap::addOption(h, "output", 'o'),
+                 ap::addOption(h, "level", 'l'),
+                 ap::setOptionValueChoices(h, "level",
+                                           {"warn", "info", "debug"}),
+                 ap::addSubcommand(h, "build", buildSpec),
+                 ap::addSubcommand(h, "bench", buildSpec),
+                 ap::addSubcommand(h, "broken", brokenSpec)})
+    if (r != ap::Result::Success)
+      return r;
+  return ap::Result::Success;
+}
+
+int complete(ap::ArgParserT *const handle, ap::CommandTokensT const &tokens,
+             std::size_t const cursor, std::vector<std::string> *const output) {
+  return ap::complete(handle, tokens.argv.data(), 0, tokens.argv.size(),
+                      cursor, output);
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc < 2) {
+    std::cerr << "Too few arguments; Usage: <input> [candidates...]\n";
+    return 1;
+  }
+
+  std::string const input = argv[1];
+  ap::CommandTokensT tokens{};
+  if (ap::tokenize(input, &tokens) != ap::Result::Success)
+    return 1;
+
+  bool const newToken = !tokens.endsInToken;
+  std::size_t const cursor = tokens.argv.size() - (newToken ? 0 : 1);
+
+  ap::ArgParserT *fresh{}, *typed{};
+  if (createSpec(&fresh) != ap::Result::Success ||
+      createSpec(&typed) != ap::Result::Success)
+    return 1;
+
+  std::vector<std::string> candidates{}, typedCandidates{};
+  bool success =
+      complete(fresh, tokens, cursor, &candidates) == ap::Result::Success;
+
+  // A query whose context cannot be scanned must not leave the context
+  // of the previous query behind, with the target of another one.
+  char const *const broken[] = {"broken", "--"};
+  success = success &&
+            complete(typed, tokens, cursor, &typedCandidates) ==
+                ap::Result::Success &&
+            ap::complete(typed, broken, 0, 2, 1, &typedCandidates) ==
+                ap::Result::ErrorArgLongFormNotValid;
+
+  if (success && newToken) {
+    success = complete(typed, tokens, cursor, &typedCandidates) ==
+                  ap::Result::Success &&
+              typedCandidates == candidates;
+  } else if (success) {
+    std::string const word = tokens.argv.back();
+    std::string prefix{};
+    for (char const c : word) {
+      prefix.push_back(c);
+      tokens.argv.back() = prefix.c_str();
+      success = success && complete(typed, tokens, cursor, &typedCandidates) ==
+                               ap::Result::Success;
+    }
+    success = success && typedCandidates == candidates;
+  }
+
+  std::cout << "input: " << input << std::endl;
+  for (auto const &candidate : candidates)
+    std::cout << "candidate: " << candidate << std::endl;
+
+  ap::destroyArgParser(fresh);
+  ap::destroyArgParser(typed);
+
+  if (!success || candidates.size() != std::size_t(argc - 2))
+    return 1;
+  for (std::size_t i = 0; i < candidates.size(); ++i)
+    if (candidates[i] != argv[i + 2])
+      return 1;
+  return 0;
+}
@@ -0,0 +1,8 @@
+add_executable(testConcurrentLogging testConcurrentLogging.cpp)
+target_link_libraries(testConcurrentLogging scopedLogger)
+
+add_test(NAME concurrentLoggingTest0001 COMMAND testConcurrentLogging 1 1000 sync)
+add_test(NAME concurrentLoggingTest0002 COMMAND testConcurrentLogging 8 2000 sync)
+add_test(NAME concurrentLoggingTest0003 COMMAND testConcurrentLogging 8 2000 async)
+add_test(NAME concurrentLoggingTest0004 COMMAND testConcurrentLogging 32 200 sync)
+add_test(NAME concurrentLoggingTest0005 COMMAND testConcurrentLogging 32 200 async)
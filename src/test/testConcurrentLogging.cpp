@@ -0,0 +1,172 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary tests a logger shared by many threads. The parameters are
+ * the number of threads, the number of messages every thread logs, and
+ * the mode (sync or async).
+ *
+ * Every thread enters its own scopes, and logs into the file and the
+ * buffer, dropping the function prefix of every third entry with
+ * a one-time property. Meanwhile, the main thread keeps toggling the
+ * warning level. Every entry must then be found in the file exactly once,
+ * intact, under the scope of the thread which logged it, and in the order
+ * that thread logged them. The trace must hold every entry, indented by
+ * the depth of its thread's scope stack.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The file and the trace hold the expected entries.
+ *
+ * 1 - An entry is missing, duplicated, or damaged.
+ */
+
+#include <badline/scopedLogger.hpp>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+void runWorker(sl::LoggerT *const logger, std::size_t const id,
+               std::size_t const count) {
+  sl::FunctionScope const scope{logger, "worker" + std::to_string(id)};
+  for (std::size_t i = 0; i < count; ++i) {
+    std::string const msg =
+        "message " + std::to_string(id) + ":" + std::to_string(i);
+    if (i % 3 == 0)
+      sl::oneTimePrefixFunc(logger, false);
+    if (i % 2) {
+      sl::FunctionScope const inner{logger, "inner" + std::to_string(id)};
+      sl::inf(logger, msg);
+    } else {
+      sl::inf(logger, msg);
+    }
+  }
+}
+
+std::string expectedEntry(std::size_t const id, std::size_t const i) {
+  std::string const msg =
+      "message " + std::to_string(id) + ":" + std::to_string(i);
+  if (i % 3 == 0)
+    return "[Info] " + msg;
+  return "[Info] " + std::string{i % 2 ? "inner" : "worker"} +
+         std::to_string(id) + ": " + msg;
+}
+
+// The entries of every thread are matched in order; an entry of another
+// thread, or a damaged one, fails the match.
+bool checkFile(std::string const &path, std::size_t const threads,
+               std::size_t const count) {
+  std::vector<std::size_t> next(threads);
+  std::size_t lines{};
+  std::ifstream file{path};
+  for (std::string line{}; std::getline(file, line); ++lines) {
+    auto const colon = line.rfind(':');
+    auto const space = line.rfind(' ', colon);
+    if (colon == std::string::npos || space == std::string::npos)
+      return false;
+    std::size_t const id = std::stoul(line.substr(space + 1));
+    if (id >= threads || next[id] >= count ||
+        line != expectedEntry(id, next[id]))
+      return false;
+    ++next[id];
+  }
+  std::cout << "lines: " << lines << std::endl;
+  return lines == threads * count;
+}
+
+bool checkTrace(sl::LoggerT *const logger, std::size_t const threads,
+                std::size_t const count) {
+  std::stringstream trace{};
+  auto *const original = std::cout.rdbuf(trace.rdbuf());
+  sl::printTrace(logger);
+  std::cout.rdbuf(original);
+
+  std::size_t lines{};
+  for (std::string line{}; std::getline(trace, line); ++lines) {
+    bool const inner = line.find("inner") != std::string::npos;
+    if (line.find(inner ? "    " : "  ") != 0 ||
+        line.find(inner ? "     " : "   ") == 0)
+      return false;
+  }
+  std::cout << "trace lines: " << lines << std::endl;
+  return lines == threads * count;
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc != 4) {
+    std::cerr << "Wrong argument count; Usage: <threads> <messages> "
+                 "<sync|async>\n";
+    return 1;
+  }
+
+  std::size_t const threads = std::stoul(argv[1]);
+  std::size_t const count = std::stoul(argv[2]);
+  bool const async = std::string{argv[3]} == "async";
+
+  auto const path =
+      (std::filesystem::temp_directory_path() /
+       ("testConcurrentLogging-" + std::to_string(::getpid()) + ".log"))
+          .string();
+  std::filesystem::remove(path);
+
+  sl::LoggerT *logger{};
+  if (sl::createLogger(&logger, "test") != sl::Result::Success)
+    return 1;
+
+  bool success = sl::outputToConsole(logger, false) == sl::Result::Success &&
+                 sl::outputToFile(logger, true) == sl::Result::Success &&
+                 sl::outputToBuffer(logger, true) == sl::Result::Success &&
+                 sl::prefixTime(logger, false) == sl::Result::Success &&
+                 sl::setLogFile(logger, path) == sl::Result::Success &&
+                 sl::resizeLogBuffer(logger, threads * count) ==
+                     sl::Result::Success &&
+                 sl::resizeLogQueue(logger, threads * count) ==
+                     sl::Result::Success &&
+                 sl::writeAsync(logger, async) == sl::Result::Success;
+
+  std::atomic<std::size_t> running{threads};
+  std::vector<std::thread> workers{};
+  for (std::size_t id = 0; success && id < threads; ++id)
+    workers.emplace_back([&, id] {
+      runWorker(logger, id, count);
+      --running;
+    });
+  for (bool v = false; running; v = !v)
+    sl::logLevelWrn(logger, v);
+  for (auto &worker : workers)
+    worker.join();
+
+  success = success && sl::flushLogFile(logger) == sl::Result::Success &&
+            checkFile(path, threads, count) &&
+            checkTrace(logger, threads, count);
+
+  sl::destroyLogger(logger);
+  std::filesystem::remove(path);
+  return success ? 0 : 1;
+}
@@ -0,0 +1,29 @@
+add_executable(testConversion testConversion.cpp)
+target_link_libraries(testConversion argParser)
+
+add_test(NAME conversionTest0001 COMMAND testConversion int "42" "42")
+add_test(NAME conversionTest0002 COMMAND testConversion int "-17" "-17")
+add_test(NAME conversionTest0003 COMMAND testConversion int "+8" "8")
+add_test(NAME conversionTest0004 COMMAND testConversion int "12ab" "error:2")
+add_test(NAME conversionTest0005 COMMAND testConversion int "99999999999999999999" "error:0")
+add_test(NAME conversionTest0006 COMMAND testConversion float "2.5" "2.5")
+add_test(NAME conversionTest0007 COMMAND testConversion float "-1e3" "-1000")
+add_test(NAME conversionTest0008 COMMAND testConversion float "1.5x" "error:3")
+add_test(NAME conversionTest0009 COMMAND testConversion bool "yes" "1")
+add_test(NAME conversionTest0010 COMMAND testConversion bool "off" "0")
+add_test(NAME conversionTest0011 COMMAND testConversion bool "maybe" "error:0")
+add_test(NAME conversionTest0012 COMMAND testConversion duration "1h30m" "5400000000000")
+add_test(NAME conversionTest0013 COMMAND testConversion duration "250ms" "250000000")
+add_test(NAME conversionTest0014 COMMAND testConversion duration "10s5x" "error:4")
+add_test(NAME conversionTest0015 COMMAND testConversion duration "200000d" "error:0")
+add_test(NAME conversionTest0016 COMMAND testConversion size "4KiB" "4096")
+add_test(NAME conversionTest0017 COMMAND testConversion size "3MB" "3000000")
+add_test(NAME conversionTest0018 COMMAND testConversion size "2G" "2147483648")
+add_test(NAME conversionTest0019 COMMAND testConversion size "5Q" "error:1")
+add_test(NAME conversionTest0020 COMMAND testConversion enum "green" "1")
+add_test(NAME conversionTest0021 COMMAND testConversion enum "violet" "error:0")
+add_test(NAME conversionTest0022 COMMAND testConversion enum "blue" "2")
+add_test(NAME conversionTest0023 COMMAND testConversion int "+-5" "error:1")
+add_test(NAME conversionTest0024 COMMAND testConversion float "+-5" "error:1")
+add_test(NAME conversionTest0025 COMMAND testConversion int "++5" "error:1")
+add_test(NAME conversionTest0026 COMMAND testConversion float "+2.5" "2.5")
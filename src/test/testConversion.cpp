@@ -0,0 +1,134 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary tests the typed option value accessors. The first parameter
+ * is the type (int, float, bool, duration, size or enum), the second one
+ * is the option value, and the third one is either the expected result
+ * or 'error:<offset>', when the conversion is expected to fail with
+ * the given error offset.
+ *
+ * Durations are expected in nanoseconds, and sizes in bytes. The choices
+ * for the enum type are 'red', 'green' and 'blue', and the expected result
+ * is the index of the value among them. The index must follow the choices
+ * when they are reordered.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The value was converted as expected.
+ *
+ * 1 - The conversion result doesn't match the expectations.
+ */
+
+#include <badline/argParser.hpp>
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+namespace {
+int convert(ap::ArgParserT *const handle, std::string const &type,
+            std::vector<std::string> const &choices,
+            std::string *const output) {
+  std::ostringstream stream{};
+  std::size_t offset{};
+  int r = ap::Result::ErrorValueNotValid;
+
+  if (type == "int") {
+    std::int64_t value{};
+    r = ap::getOptionInstanceInt(handle, "value", 0, &value, &offset);
+    stream << value;
+  } else if (type == "float") {
+    double value{};
+    r = ap::getOptionInstanceFloat(handle, "value", 0, &value, &offset);
+    stream << value;
+  } else if (type == "bool") {
+    bool value{};
+    r = ap::getOptionInstanceBool(handle, "value", 0, &value, &offset);
+    stream << value;
+  } else if (type == "duration") {
+    std::chrono::nanoseconds value{};
+    r = ap::getOptionInstanceDuration(handle, "value", 0, &value, &offset);
+    stream << value.count();
+  } else if (type == "size") {
+    std::uint64_t value{};
+    r = ap::getOptionInstanceSize(handle, "value", 0, &value, &offset);
+    stream << value;
+  } else if (type == "enum") {
+    std::size_t value{};
+    r = ap::getOptionInstanceEnum(handle, "value", 0, choices, &value,
+                                  &offset);
+    stream << value;
+  } else {
+    *output = "unknown type";
+    return r;
+  }
+
+  if (r == ap::Result::Success) {
+    *output = stream.str();
+  } else {
+    *output = "error:" + std::to_string(offset);
+  }
+  return r;
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc != 4) {
+    std::cerr << "Wrong argument count; Usage: <type> <input> <expected>\n";
+    return 1;
+  }
+
+  std::string const type = argv[1];
+  std::string const expected = argv[3];
+  char const *const input[] = {"--value", "--", argv[2]};
+
+  ap::ArgParserT *handle{};
+  if (ap::createArgParser(&handle) != ap::Result::Success)
+    return 1;
+
+  std::string output{};
+  bool success = ap::addOption(handle, "value") == ap::Result::Success &&
+                 ap::parse(handle, input, 0, 3) == ap::Result::Success;
+
+  // The second call is answered from the cached conversion. The choices
+  // are then rotated in place, which must not be answered from it.
+  std::vector<std::string> choices{"red", "green", "blue"};
+  std::string cached{}, rotated{};
+  if (success) {
+    auto const r = convert(handle, type, choices, &output);
+    success = convert(handle, type, choices, &cached) == r && cached == output;
+  }
+
+  if (success && type == "enum") {
+    std::rotate(choices.begin(), choices.begin() + 1, choices.end());
+    auto const r = convert(handle, type, choices, &rotated);
+    success = r == ap::Result::Success
+                  ? std::to_string((std::stoul(rotated) + 1) % 3) == output
+                  : rotated == output;
+  }
+
+  std::cout << "type: " << type << std::endl;
+  std::cout << "input: " << argv[2] << std::endl;
+  std::cout << "output: " << output << std::endl;
+
+  ap::destroyArgParser(handle);
+  return success && output == expected ? 0 : 1;
+}
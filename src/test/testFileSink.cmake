@@ -0,0 +1,11 @@
+add_executable(testFileSink testFileSink.cpp)
+target_link_libraries(testFileSink scopedLogger)
+
+add_test(NAME fileSinkTest0001 COMMAND testFileSink record 0 sync early)
+add_test(NAME fileSinkTest0002 COMMAND testFileSink bytes 256 sync early)
+add_test(NAME fileSinkTest0003 COMMAND testFileSink bytes 65536 sync late)
+add_test(NAME fileSinkTest0004 COMMAND testFileSink interval 20 sync early)
+add_test(NAME fileSinkTest0005 COMMAND testFileSink interval 60000 sync late)
+add_test(NAME fileSinkTest0006 COMMAND testFileSink error 0 sync early)
+add_test(NAME fileSinkTest0007 COMMAND testFileSink record 0 async early)
+add_test(NAME fileSinkTest0008 COMMAND testFileSink bytes 65536 async late)
@@ -0,0 +1,146 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary tests the File output mode. The parameters are the flush
+ * policy (record, bytes, interval or error), its threshold, the mode
+ * (sync or async), and whether the entries are expected in the file
+ * before it is flushed explicitly (early) or not (late).
+ *
+ * 100 informational entries are logged, followed by one error, after
+ * a pause of 50ms for the interval policy. The entries
+ * are then flushed, and the file must hold all of them, in order. In
+ * the asynchronous mode, the early check is skipped, as it depends on
+ * the writer thread.
+ *
+ * A second logger writes to /dev/full with the same mode, and its
+ * explicit flush must report the failed write.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The file holds the expected entries.
+ *
+ * 1 - The file doesn't hold the expected entries, or it couldn't
+ *     be written.
+ */
+
+#include <badline/scopedLogger.hpp>
+#include <filesystem>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+std::vector<std::string> readLines(std::string const &path) {
+  std::vector<std::string> lines{};
+  std::ifstream file{path};
+  for (std::string line{}; std::getline(file, line);)
+    lines.push_back(line);
+  return lines;
+}
+
+int parsePolicy(std::string const &name) {
+  if (name == "record")
+    return sl::FlushPolicy::Record;
+  if (name == "bytes")
+    return sl::FlushPolicy::Bytes;
+  if (name == "interval")
+    return sl::FlushPolicy::Interval;
+  if (name == "error")
+    return sl::FlushPolicy::Error;
+  return -1;
+}
+
+bool flushReportsFailure(bool const async) {
+  sl::LoggerT *logger{};
+  if (sl::createLogger(&logger, "full") != sl::Result::Success)
+    return false;
+
+  bool const success =
+      sl::outputToConsole(logger, false) == sl::Result::Success &&
+      sl::outputToFile(logger, true) == sl::Result::Success &&
+      sl::setLogFile(logger, "/dev/full") == sl::Result::Success &&
+      sl::writeAsync(logger, async) == sl::Result::Success &&
+      sl::inf(logger, "lost") == sl::Result::Success &&
+      sl::flushLogFile(logger) == sl::Result::ErrorFileAccessFailure;
+  sl::destroyLogger(logger);
+  return success;
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc != 5) {
+    std::cerr << "Wrong argument count; Usage: <policy> <threshold> "
+                 "<sync|async> <early|late>\n";
+    return 1;
+  }
+
+  int const policy = parsePolicy(argv[1]);
+  std::size_t const threshold = std::stoul(argv[2]);
+  bool const async = std::string{argv[3]} == "async";
+  bool const early = std::string{argv[4]} == "early";
+
+  auto const path = (std::filesystem::temp_directory_path() /
+                     ("testFileSink-" + std::to_string(::getpid()) + ".log"))
+                        .string();
+  std::filesystem::remove(path);
+
+  sl::LoggerT *logger{};
+  if (sl::createLogger(&logger, "test") != sl::Result::Success)
+    return 1;
+
+  bool success = sl::outputToConsole(logger, false) == sl::Result::Success &&
+                 sl::outputToFile(logger, true) == sl::Result::Success &&
+                 sl::prefixTime(logger, false) == sl::Result::Success &&
+                 sl::setLogFile(logger, path) == sl::Result::Success &&
+                 sl::setLogFileFlushPolicy(logger, policy, threshold) ==
+                     sl::Result::Success &&
+                 sl::writeAsync(logger, async) == sl::Result::Success;
+
+  for (std::size_t i = 0; success && i < 100; ++i)
+    success = sl::inf(logger, "message " + std::to_string(i)) ==
+              sl::Result::Success;
+  if (policy == sl::FlushPolicy::Interval)
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  success = success && sl::err(logger, "last") == sl::Result::Success;
+
+  bool const written = !readLines(path).empty();
+  std::cout << "written before the flush: " << written << std::endl;
+  if (!async && written != early)
+    success = false;
+
+  success = success && sl::flushLogFile(logger) == sl::Result::Success;
+  auto const lines = readLines(path);
+  sl::destroyLogger(logger);
+  std::filesystem::remove(path);
+
+  std::cout << "lines: " << lines.size() << std::endl;
+  success = success && flushReportsFailure(async);
+  if (!success || lines.size() != 101)
+    return 1;
+  for (std::size_t i = 0; i < 100; ++i)
+    if (lines[i] != "[Info] test: message " + std::to_string(i))
+      return 1;
+  return lines[100] == "[Error] test: last" ? 0 : 1;
+}
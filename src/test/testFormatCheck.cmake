@@ -0,0 +1,15 @@
+# Every case is only built by its test, which expects the ones with a
+# malformed format to fail to compile.
+foreach(case RANGE 4)
+  add_executable(testFormatCheck${case} EXCLUDE_FROM_ALL testFormatCheck.cpp)
+  target_link_libraries(testFormatCheck${case} scopedLogger)
+  target_compile_definitions(testFormatCheck${case} PRIVATE FORMAT_CASE=${case})
+
+  math(EXPR number "${case} + 1")
+  add_test(NAME formatCheckTest000${number}
+           COMMAND ${CMAKE_COMMAND} --build ${CMAKE_BINARY_DIR}
+                   --target testFormatCheck${case})
+  if(case GREATER 0)
+    set_tests_properties(formatCheckTest000${number} PROPERTIES WILL_FAIL TRUE)
+  endif()
+endforeach()
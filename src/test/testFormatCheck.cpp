@@ -0,0 +1,58 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This source tests that the formats of the logging macros are checked at
+ * compile time. It is compiled once for every FORMAT_CASE, and only the
+ * first case, with a format matching its arguments, may compile: the
+ * others have too few arguments, too many, an unmatched opening brace,
+ * and an unmatched closing brace.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The case compiled, and the entry was logged.
+ *
+ * 1 - The entry couldn't be logged.
+ */
+
+#include <badline/scopedLogger.hpp>
+
+int main() {
+  sl::LoggerT *logger{};
+  if (sl::createLogger(&logger, "test") != sl::Result::Success)
+    return 1;
+  sl::outputToConsole(logger, false);
+
+#if FORMAT_CASE == 0
+  SL_INF(logger, "{} and {{{}}}", 1, "two");
+#elif FORMAT_CASE == 1
+  SL_INF(logger, "{} and {}", 1);
+#elif FORMAT_CASE == 2
+  SL_INF(logger, "{}", 1, 2);
+#elif FORMAT_CASE == 3
+  SL_INF(logger, "{ {}", 1);
+#elif FORMAT_CASE == 4
+  SL_INF(logger, "{} }", 1);
+#endif
+
+  sl::destroyLogger(logger);
+  return 0;
+}
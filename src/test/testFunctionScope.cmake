@@ -0,0 +1,7 @@
+add_executable(testFunctionScope testFunctionScope.cpp)
+target_link_libraries(testFunctionScope scopedLogger)
+
+add_test(NAME functionScopeTest0001 COMMAND testFunctionScope 0)
+add_test(NAME functionScopeTest0002 COMMAND testFunctionScope 3)
+add_test(NAME functionScopeTest0003 COMMAND testFunctionScope 255)
+add_test(NAME functionScopeTest0004 COMMAND testFunctionScope 1000)
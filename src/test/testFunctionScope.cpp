@@ -0,0 +1,162 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary tests the scope stack kept by FunctionScope. The parameter
+ * is the number of nested scopes to enter, which may exceed the capacity
+ * of the stack.
+ *
+ * Entering and leaving a scope named by a string literal, or by a name
+ * that was already interned, must not allocate once the thread uses the
+ * logger. The trace must name every entry after the innermost scope kept,
+ * whether it was named by a literal, a string or SL_FUNCTION_SCOPE, at
+ * the depth of the scope, and after the logger once the scopes are left.
+ * A scope named by an array of characters which changes once the scope
+ * is left must keep its name in the profile.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The trace holds the expected entries, and the scopes didn't
+ *     allocate.
+ *
+ * 1 - The trace doesn't hold the expected entries, or a scope allocated.
+ */
+
+#include <badline/scopedLogger.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+std::size_t allocations{};
+
+void nest(sl::LoggerT *const logger, std::size_t const depth) {
+  if (!depth) {
+    sl::inf(logger, "deepest");
+    return;
+  }
+  sl::FunctionScope const scope{logger, "nested"};
+  nest(logger, depth - 1);
+}
+
+void named(sl::LoggerT *const logger) {
+  SL_FUNCTION_SCOPE(logger);
+  sl::inf(logger, "function");
+}
+
+// The profile reads the names of the scopes after they are left.
+bool keepsArrayName(sl::LoggerT *const logger) {
+  char name[] = "mutable";
+  if (sl::profileScopes(logger, true) != sl::Result::Success)
+    return false;
+  {
+    sl::FunctionScope const scope{logger, name};
+  }
+  name[0] = 'M';
+
+  sl::ScopeProfile profile{};
+  bool const found =
+      sl::getScopeProfile(logger, &profile) == sl::Result::Success &&
+      std::any_of(profile.entries.begin(), profile.entries.end(),
+                  [](auto const &e) { return e.path == "test;mutable"; });
+  return sl::profileScopes(logger, false) == sl::Result::Success && found;
+}
+
+// Returns the allocations made by entering and leaving the scopes.
+std::size_t enterScopes(sl::LoggerT *const logger, std::string const &name) {
+  std::size_t const before = allocations;
+  for (int i = 0; i < 1000; ++i) {
+    sl::FunctionScope const outer{logger, "outer"};
+    sl::FunctionScope const inner{logger, name};
+  }
+  return allocations - before;
+}
+} // namespace
+
+void *operator new(std::size_t const size) {
+  ++allocations;
+  if (void *const p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc{};
+}
+
+void operator delete(void *const p) noexcept { std::free(p); }
+void operator delete(void *const p, std::size_t) noexcept { std::free(p); }
+
+int main(int const argc, char const *const *const argv) {
+  if (argc != 2) {
+    std::cerr << "Wrong argument count; Usage: <depth>\n";
+    return 1;
+  }
+
+  std::size_t const depth = std::stoul(argv[1]);
+  sl::LoggerT *logger{};
+  if (sl::createLogger(&logger, "test") != sl::Result::Success)
+    return 1;
+  bool success = sl::outputToConsole(logger, false) == sl::Result::Success &&
+                 sl::outputToBuffer(logger, true) == sl::Result::Success;
+
+  std::string const name{"dynamic"};
+  enterScopes(logger, name);
+  std::size_t const allocated = enterScopes(logger, name);
+  std::cout << "allocations: " << allocated << std::endl;
+
+  {
+    sl::FunctionScope const outer{logger, "outer"};
+    sl::FunctionScope const inner{logger, name};
+    sl::inf(logger, "string");
+  }
+  named(logger);
+  nest(logger, depth);
+  sl::inf(logger, "root");
+
+  std::stringstream trace{};
+  auto *const original = std::cout.rdbuf(trace.rdbuf());
+  sl::printTrace(logger);
+  std::cout.rdbuf(original);
+  std::cout << trace.str();
+
+  // The trace indents every entry by its depth, two spaces a level.
+  std::vector<std::pair<std::size_t, std::string>> const expected{
+      {2, "dynamic: string"},
+      {1, "named: function"},
+      {depth, (depth ? "nested" : "test") + std::string{": deepest"}},
+      {0, "test: root"}};
+  std::vector<std::pair<std::size_t, std::string>> entries{};
+  for (std::string line{}; std::getline(trace, line);) {
+    auto const indent = line.find_first_not_of(' ');
+    auto const pos = line.find("] ");
+    if (indent == std::string::npos || pos == std::string::npos) {
+      success = false;
+      break;
+    }
+    entries.emplace_back(indent / 2, line.substr(pos + 2));
+  }
+
+  success = success && !allocated && entries == expected &&
+            keepsArrayName(logger);
+  sl::destroyLogger(logger);
+  return success ? 0 : 1;
+}
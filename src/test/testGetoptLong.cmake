@@ -0,0 +1,15 @@
+add_executable(testGetoptLong testGetoptLong.cpp)
+target_link_libraries(testGetoptLong argParser)
+
+add_test(NAME getoptLongTest0001 COMMAND testGetoptLong "ab:c::" "-a" "-bvalue" "-b" "next" "-cx" "-c")
+add_test(NAME getoptLongTest0002 COMMAND testGetoptLong "ab:" "one" "-a" "two" "-b" "v" "three" "--verbose")
+add_test(NAME getoptLongTest0003 COMMAND testGetoptLong "ab" "-ab" "-ba" "-x" "-a:" "-")
+add_test(NAME getoptLongTest0004 COMMAND testGetoptLong "a" "--output=file" "--output" "file" "--optional" "--optional=x")
+add_test(NAME getoptLongTest0005 COMMAND testGetoptLong "a" "--verb" "--ver" "--out" "f" "--version" "--unknown")
+add_test(NAME getoptLongTest0006 COMMAND testGetoptLong "a" "x" "--verbose=1" "y" "--" "-a" "z")
+add_test(NAME getoptLongTest0007 COMMAND testGetoptLong "+a" "-a" "x" "-a")
+add_test(NAME getoptLongTest0008 COMMAND testGetoptLong "-a" "x" "-a" "y" "--" "-a")
+add_test(NAME getoptLongTest0009 COMMAND testGetoptLong ":ab:" "-b" "--output" "-q")
+add_test(NAME getoptLongTest0010 COMMAND testGetoptLong "ab:" "x" "y" "-b" "-a" "z" "--output" "-" "w" "-a")
+add_test(NAME getoptLongTest0011 COMMAND testGetoptLong "a")
+add_test(NAME getoptLongTest0012 COMMAND testGetoptLong "a" "x" "--")
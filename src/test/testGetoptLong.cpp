@@ -0,0 +1,126 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary compares 'ap_getopt_long' against the getopt_long of the C
+ * library. The first parameter is the option string, and the remaining
+ * parameters are the arguments to scan, preceded by the program name.
+ *
+ * The long options are 'verbose' and 'verbatim', both returning 'v',
+ * 'version', which sets a flag, 'output', which requires an argument
+ * returning 'o', and 'optional', whose argument is optional, returning
+ * 'p'. Both implementations must return the same values, with the same
+ * optind, optarg, optopt and option index, and must leave the arguments
+ * in the same order.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - Both implementations behave the same.
+ *
+ * 1 - The implementations differ.
+ */
+
+#include <badline/getoptLong.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+int flag = 0;
+
+option const longOptions[] = {{"verbose", no_argument, nullptr, 'v'},
+                              {"verbatim", no_argument, nullptr, 'v'},
+                              {"version", no_argument, &flag, 1},
+                              {"output", required_argument, nullptr, 'o'},
+                              {"optional", optional_argument, nullptr, 'p'},
+                              {nullptr, 0, nullptr, 0}};
+
+using GetoptT = int (*)(int, char *const[], char const *, option const *,
+                        int *);
+
+// Records every call as a line holding its results, followed by the final
+// order of the arguments.
+std::vector<std::string> scan(GetoptT const getopt, int *const index,
+                              char **const optionArg, int *const option,
+                              std::string const &optionString,
+                              std::vector<std::string> const &input) {
+  std::vector<std::string> arguments = input;
+  std::vector<char *> argv{};
+  for (auto &argument : arguments)
+    argv.push_back(argument.data());
+  argv.push_back(nullptr);
+
+  std::vector<std::string> trace{};
+  int const argc = argv.size() - 1;
+  for (int i = 0; i < argc + 4; ++i) {
+    int longIndex = -1;
+    flag = 0;
+    int const r =
+        getopt(argc, argv.data(), optionString.c_str(), longOptions, &longIndex);
+
+    std::string line = std::to_string(r) + " optind=" + std::to_string(*index);
+    line += " optarg=" + std::string(*optionArg ? *optionArg : "(null)");
+    if (r == '?' || r == ':')
+      line += " optopt=" + std::to_string(*option);
+    line += " index=" + std::to_string(longIndex);
+    line += " flag=" + std::to_string(flag);
+    trace.push_back(line);
+    if (r == -1)
+      break;
+  }
+
+  std::string order = "argv:";
+  for (int i = 0; i < argc; ++i)
+    order += std::string(" ") + argv[i];
+  trace.push_back(order);
+  return trace;
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc < 2) {
+    std::cerr << "Too few arguments; Usage: <optstring> [arguments...]\n";
+    return 1;
+  }
+
+  std::string const optionString = argv[1];
+  std::vector<std::string> input{"program"};
+  for (int i = 2; i < argc; ++i)
+    input.push_back(argv[i]);
+
+  opterr = 0;
+  ap_opterr = 0;
+  optind = 0;
+  ap_optind = 0;
+  auto const expected =
+      scan(getopt_long, &optind, &optarg, &optopt, optionString, input);
+  auto const actual = scan(ap_getopt_long, &ap_optind, &ap_optarg, &ap_optopt,
+                           optionString, input);
+
+  bool same = expected.size() == actual.size();
+  for (std::size_t i = 0; i < std::max(expected.size(), actual.size()); ++i) {
+    std::string const e = i < expected.size() ? expected[i] : "";
+    std::string const a = i < actual.size() ? actual[i] : "";
+    std::cout << "expected: " << e << "\nactual:   " << a << std::endl;
+    same = same && e == a;
+  }
+  return same ? 0 : 1;
+}
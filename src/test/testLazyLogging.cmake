@@ -0,0 +1,10 @@
+add_executable(testLazyLogging testLazyLogging.cpp)
+target_link_libraries(testLazyLogging scopedLogger)
+
+add_executable(testLazyLoggingMinWarning testLazyLogging.cpp)
+target_link_libraries(testLazyLoggingMinWarning scopedLogger)
+target_compile_definitions(testLazyLoggingMinWarning
+                           PRIVATE SL_MIN_LEVEL=SL_LEVEL_WARNING)
+
+add_test(NAME lazyLoggingTest0001 COMMAND testLazyLogging)
+add_test(NAME lazyLoggingTest0002 COMMAND testLazyLoggingMinWarning)
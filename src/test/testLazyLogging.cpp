@@ -0,0 +1,107 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary tests that the logging macros only evaluate their arguments
+ * for the entries which are written. It is built twice: with the default
+ * minimum level, and with SL_MIN_LEVEL set to SL_LEVEL_WARNING, which must
+ * compile the SL_INF calls out.
+ *
+ * Every level is logged once while enabled, and once while disabled, with
+ * an argument counting its evaluations. The file the entries are written
+ * to must hold the enabled ones at or above the minimum level, and the
+ * arguments must have been evaluated once for every one of them.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The entries and the evaluations match the expected ones.
+ *
+ * 1 - The entries or the evaluations don't match the expected ones.
+ */
+
+#include <badline/scopedLogger.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+int evaluations{};
+
+int evaluate(int const v) {
+  ++evaluations;
+  return v;
+}
+
+void emit(sl::LoggerT *const logger, int const round) {
+  SL_INF(logger, "info {}", evaluate(round));
+  SL_WRN(logger, "warning {}", evaluate(round));
+  SL_ERR(logger, "error {} {{}}", evaluate(round));
+}
+
+std::vector<std::string> readLines(std::string const &path) {
+  std::vector<std::string> lines{};
+  std::ifstream file{path};
+  for (std::string line{}; std::getline(file, line);)
+    lines.push_back(line);
+  return lines;
+}
+} // namespace
+
+int main() {
+  auto const path = (std::filesystem::temp_directory_path() /
+                     ("testLazyLogging-" + std::to_string(::getpid()) + ".log"))
+                        .string();
+
+  sl::LoggerT *logger{};
+  if (sl::createLogger(&logger, "test") != sl::Result::Success)
+    return 1;
+
+  bool success = sl::outputToConsole(logger, false) == sl::Result::Success &&
+                 sl::outputToFile(logger, true) == sl::Result::Success &&
+                 sl::prefixTime(logger, false) == sl::Result::Success &&
+                 sl::setLogFile(logger, path) == sl::Result::Success;
+
+  emit(logger, 1);
+  success = success && sl::logLevelInf(logger, false) == sl::Result::Success &&
+            sl::logLevelWrn(logger, false) == sl::Result::Success &&
+            sl::logLevelErr(logger, false) == sl::Result::Success;
+  emit(logger, 2);
+  success = success && sl::flushLogFile(logger) == sl::Result::Success;
+  sl::destroyLogger(logger);
+
+  std::vector<std::string> expected{"[Warning] test: warning 1",
+                                    "[Error] test: error 1 {}"};
+  if (SL_MIN_LEVEL <= SL_LEVEL_INFO)
+    expected.insert(expected.begin(), "[Info] test: info 1");
+
+  auto const entries = readLines(path);
+  for (auto const &entry : entries)
+    std::cout << entry << "\n";
+  std::cout << "evaluations: " << evaluations << std::endl;
+  std::filesystem::remove(path);
+  return success && entries == expected &&
+                 evaluations == int(expected.size())
+             ? 0
+             : 1;
+}
@@ -0,0 +1,7 @@
+add_executable(testParseStats testParseStats.cpp)
+target_link_libraries(testParseStats argParser)
+
+add_test(NAME parseStatsTest0001 COMMAND testParseStats "--level=high")
+add_test(NAME parseStatsTest0002 COMMAND testParseStats "-v" "--verbose" "value")
+add_test(NAME parseStatsTest0003 COMMAND testParseStats "--dry-run" "-l" "low" "x" "--level=medium")
+add_test(NAME parseStatsTest0004 COMMAND testParseStats "--dry-run" "--" "--level=high")
@@ -0,0 +1,127 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary tests the statistics returned by 'getParseStats'.
+ * The parameters are the command line to parse, with the flags 'verbose'
+ * (v) and 'dry-run', and the option 'level' (l) registered.
+ *
+ * The command line is parsed twice, so that the statistics are shown
+ * to be reset by every parse. The token counts are checked against
+ * the tokens which cannot be classified without the grammar, and
+ * the chart counters against the size of the chart of every such token.
+ * A handle which doesn't collect statistics must report none.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The statistics match the expectations.
+ *
+ * 1 - The input was rejected, or the statistics don't match.
+ */
+
+#include <argParser/internals.hpp>
+#include <iostream>
+#include <utility>
+
+namespace {
+bool parse(ap::ArgParserT *const handle, bool const collect,
+           char const *const *const input, std::size_t const size) {
+  return ap::addFlag(handle, "verbose", 'v') == ap::Result::Success &&
+         ap::addFlag(handle, "dry-run") == ap::Result::Success &&
+         ap::addOption(handle, "level", 'l') == ap::Result::Success &&
+         ap::collectParseStats(handle, collect) == ap::Result::Success &&
+         ap::parse(handle, input, 0, size) == ap::Result::Success;
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc < 2) {
+    std::cerr << "Too few arguments; Usage: <input...>\n";
+    return 1;
+  }
+
+  ap::ParsingDatabaseT database{};
+  ap::fillParsingDatabase(&database);
+  std::size_t variants{};
+  for (auto const &rule : database.grammar)
+    variants += rule.size();
+
+  // Every cell above the first row is evaluated once, and tests every
+  // variant of every rule once per split point. The token following
+  // '--' is taken verbatim.
+  ap::ParseStatsT expected{};
+  std::size_t const size = argc - 1;
+  bool verbatim{};
+  for (std::size_t i = 1; i < std::size_t(argc); ++i) {
+    std::string const token = argv[i];
+    bool ascii{};
+    database.tokenInfo = {};
+    ++expected.tokensSeen;
+    if (std::exchange(verbatim, token == "--") || verbatim ||
+        token.size() < 2 || ap::validateToken(token, &ascii) ||
+        ap::classifyToken(&database, &token, ascii))
+      continue;
+
+    std::size_t const n = token.size();
+    ++expected.grammarTokens;
+    for (std::size_t row = 1; row < n; ++row) {
+      expected.cellsEvaluated += n - row;
+      expected.variantsTested += (n - row) * row * variants;
+    }
+  }
+
+  ap::ArgParserT *handle{}, *disabled{};
+  if (ap::createArgParser(&handle) != ap::Result::Success)
+    return 1;
+  if (ap::createArgParser(&disabled) != ap::Result::Success) {
+    ap::destroyArgParser(handle);
+    return 1;
+  }
+
+  bool success = parse(handle, true, argv + 1, size) &&
+                 ap::parse(handle, argv + 1, 0, size) == ap::Result::Success &&
+                 parse(disabled, false, argv + 1, size);
+
+  ap::ParseStatsT stats{}, none{};
+  ap::getParseStats(handle, &stats);
+  ap::getParseStats(disabled, &none);
+
+  std::cout << "tokensSeen: " << stats.tokensSeen << std::endl;
+  std::cout << "grammarTokens: " << stats.grammarTokens << std::endl;
+  std::cout << "cellsEvaluated: " << stats.cellsEvaluated << std::endl;
+  std::cout << "variantsTested: " << stats.variantsTested << std::endl;
+  std::cout << "backPointers: " << stats.backPointers << std::endl;
+  std::cout << "peakChartBytes: " << stats.peakChartBytes << std::endl;
+
+  bool const grammarUsed = expected.grammarTokens > 0;
+  success = success && stats.tokensSeen == expected.tokensSeen &&
+            stats.grammarTokens == expected.grammarTokens &&
+            stats.cellsEvaluated == expected.cellsEvaluated &&
+            stats.variantsTested == expected.variantsTested &&
+            (stats.backPointers > 0) == grammarUsed &&
+            (stats.peakChartBytes > 0) == grammarUsed &&
+            (stats.parseCYKNs > 0) == grammarUsed && !none.tokensSeen &&
+            !none.grammarTokens && !none.cellsEvaluated && !none.parseCYKNs;
+
+  ap::destroyArgParser(handle);
+  ap::destroyArgParser(disabled);
+  return success ? 0 : 1;
+}
@@ -0,0 +1,14 @@
+add_executable(testRingFile testRingFile.cpp)
+target_link_libraries(testRingFile scopedLogger)
+
+add_test(NAME ringFileTest0001 COMMAND testRingFile 4096 10 sync exit)
+add_test(NAME ringFileTest0002 COMMAND testRingFile 512 200 sync exit)
+add_test(NAME ringFileTest0003 COMMAND testRingFile 1000 1000 sync crash)
+add_test(NAME ringFileTest0004 COMMAND testRingFile 4096 10 sync crash)
+add_test(NAME ringFileTest0005 COMMAND testRingFile 1024 500 async exit)
+add_test(NAME ringFileTest0006 COMMAND testRingFile 1024 500 async crash)
+add_test(NAME ringFileTest0007 COMMAND testRingFile 64 20 sync exit)
+add_test(NAME ringFileTest0008 COMMAND testRingFile 100 30 sync exit 92,28,86)
+add_test(NAME ringFileTest0009 COMMAND testRingFile 256 100 async crash
+                                      200,40,180,60)
+add_test(NAME ringFileTest0010 COMMAND testRingFile 128 50 sync exit 120,24)
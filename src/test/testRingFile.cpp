@@ -0,0 +1,217 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary tests the RingFile output mode. The parameters are the size
+ * of the ring file, the number of entries to log, the mode (sync or
+ * async), how the logging process ends (exit or crash), and optionally
+ * the lengths of the entries, separated by commas and used in turn, the
+ * messages being padded up to them.
+ *
+ * A forked process logs the entries, and then either destroys the logger
+ * or kills itself without unmapping the file. The entries read back from
+ * the file must be the most recent ones, in order, and the file must be
+ * full once it wrapped around. The file is then reopened, and an entry
+ * logged after the recovered ones. Finally, the length of the oldest
+ * record is overwritten, and the file reopened once more, which has to
+ * start it over instead of appending to records that can't be walked.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The file holds the expected entries.
+ *
+ * 1 - The file doesn't hold the expected entries, or it couldn't
+ *     be written.
+ */
+
+#include <badline/scopedLogger.hpp>
+#include <scopedLogger/internals.hpp>
+#include <algorithm>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+std::string const entryPrefix{"[Info] test: "};
+std::vector<std::size_t> entryLengths{};
+
+std::string makeMessage(std::size_t const i) {
+  std::string message = "message " + std::to_string(i);
+  if (!entryLengths.empty()) {
+    std::size_t const length = entryLengths[i % entryLengths.size()];
+    message.resize(std::max(message.size(), length - entryPrefix.size() - 1),
+                   'x');
+  }
+  return message;
+}
+
+std::string makeEntry(std::size_t const i) {
+  return entryPrefix + makeMessage(i) + "\n";
+}
+
+sl::LoggerT *createRingLogger(std::string const &path, std::size_t size) {
+  sl::LoggerT *logger{};
+  if (sl::createLogger(&logger, "test") != sl::Result::Success)
+    return nullptr;
+  if (sl::outputToConsole(logger, false) != sl::Result::Success ||
+      sl::outputToRingFile(logger, true) != sl::Result::Success ||
+      sl::prefixTime(logger, false) != sl::Result::Success ||
+      sl::setRingLogFile(logger, path, size) != sl::Result::Success) {
+    sl::destroyLogger(logger);
+    return nullptr;
+  }
+  return logger;
+}
+
+int runChild(std::string const &path, std::size_t const size,
+             std::size_t const count, bool const async, bool const crash) {
+  auto *const logger = createRingLogger(path, size);
+  if (!logger || sl::writeAsync(logger, async) != sl::Result::Success)
+    return 1;
+  for (std::size_t i = 0; i < count; ++i)
+    if (sl::inf(logger, makeMessage(i)) != sl::Result::Success)
+      return 1;
+
+  if (crash) {
+    sl::flushLogQueue(logger);
+    ::kill(::getpid(), SIGKILL);
+  }
+  sl::destroyLogger(logger);
+  return 0;
+}
+
+// Gives the oldest record of the file a length reaching past the head.
+bool corruptTail(std::string const &path) {
+  std::fstream file{path, std::ios::in | std::ios::out | std::ios::binary};
+  std::uint64_t tail{}, capacity{};
+  file.seekg(sl::ringFileTailOffset);
+  file.read(reinterpret_cast<char *>(&tail), sizeof(tail));
+  file.seekg(sl::ringFileCapacityOffset);
+  file.read(reinterpret_cast<char *>(&capacity), sizeof(capacity));
+  if (!file || !capacity)
+    return false;
+
+  std::uint32_t const length = 0x7FFFFFF0;
+  file.seekp(sl::ringFileHeaderSize + tail % capacity);
+  file.write(reinterpret_cast<char const *>(&length), sizeof(length));
+  return bool(file);
+}
+
+// The entries have to be the last ones logged, and a wrapped file can't
+// have room left for another one. With entries of different lengths, the
+// dropped one and the padding at the end of up to two laps may be missing.
+bool checkEntries(std::vector<std::string> const &entries,
+                  std::size_t const count, std::size_t const wraps,
+                  std::size_t const size) {
+  std::size_t bytes{};
+  for (std::size_t i = 0; i < entries.size(); ++i) {
+    if (entries[i] != makeEntry(count - entries.size() + i))
+      return false;
+    bytes += 4 + (entries[i].size() + 3) / 4 * 4;
+  }
+  std::cout << "entries: " << entries.size() << ", wraps: " << wraps
+            << std::endl;
+  if (!wraps)
+    return entries.size() == count;
+  std::size_t longest = makeEntry(count).size();
+  for (std::size_t const length : entryLengths)
+    longest = std::max(longest, length);
+  std::size_t const slack = entryLengths.empty() ? 2 : 3;
+  return entries.size() && bytes + slack * (4 + longest) > size;
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc != 5 && argc != 6) {
+    std::cerr << "Wrong argument count; Usage: <size> <count> <sync|async> "
+                 "<exit|crash> [lengths]\n";
+    return 1;
+  }
+
+  std::size_t const size = std::stoul(argv[1]);
+  std::size_t const count = std::stoul(argv[2]);
+  bool const async = std::string{argv[3]} == "async";
+  bool const crash = std::string{argv[4]} == "crash";
+  if (argc == 6) {
+    std::stringstream lengths{argv[5]};
+    for (std::string length{}; std::getline(lengths, length, ',');)
+      entryLengths.push_back(std::stoul(length));
+  }
+
+  auto const path = (std::filesystem::temp_directory_path() /
+                     ("testRingFile-" + std::to_string(::getpid()) + ".log"))
+                        .string();
+  std::filesystem::remove(path);
+
+  pid_t const pid = ::fork();
+  if (pid < 0)
+    return 1;
+  if (!pid)
+    ::_exit(runChild(path, size, count, async, crash));
+
+  int status{};
+  ::waitpid(pid, &status, 0);
+  bool const ended = crash ? WIFSIGNALED(status)
+                           : WIFEXITED(status) && !WEXITSTATUS(status);
+
+  std::vector<std::string> entries{};
+  std::size_t wraps{};
+  bool success = ended &&
+                 sl::readRingLogFile(path, &entries, &wraps) ==
+                     sl::Result::Success &&
+                 checkEntries(entries, count, wraps, size);
+
+  // A reopened file continues after the recovered entries.
+  if (success) {
+    auto *const logger = createRingLogger(path, size);
+    success = logger &&
+              sl::inf(logger, makeMessage(count)) ==
+                  sl::Result::Success;
+    sl::destroyLogger(logger);
+    success = success &&
+              sl::readRingLogFile(path, &entries, &wraps) ==
+                  sl::Result::Success &&
+              checkEntries(entries, count + 1, wraps, size);
+  }
+
+  if (success) {
+    success = corruptTail(path);
+    auto *const logger = success ? createRingLogger(path, size) : nullptr;
+    success = logger &&
+              sl::inf(logger, makeMessage(count + 1)) ==
+                  sl::Result::Success;
+    sl::destroyLogger(logger);
+    success = success &&
+              sl::readRingLogFile(path, &entries, &wraps) ==
+                  sl::Result::Success &&
+              entries.size() == 1 && entries[0] == makeEntry(count + 1) &&
+              !wraps;
+  }
+
+  std::filesystem::remove(path);
+  return success ? 0 : 1;
+}
@@ -0,0 +1,6 @@
+add_executable(testScopeProfile testScopeProfile.cpp)
+target_link_libraries(testScopeProfile scopedLogger)
+
+add_test(NAME scopeProfileTest0001 COMMAND testScopeProfile tree)
+add_test(NAME scopeProfileTest0002 COMMAND testScopeProfile threads)
+add_test(NAME scopeProfileTest0003 COMMAND testScopeProfile overflow)
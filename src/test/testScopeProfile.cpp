@@ -0,0 +1,227 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary tests the profiling mode of the scopes. The parameter is
+ * the case to run: 'tree' profiles nested scopes on one thread, 'threads'
+ * on several threads, and 'overflow' into buffers too small to hold all
+ * of them.
+ *
+ * The profile must hold every path of the call tree entered while the
+ * profiling mode was on, with its call count, and with its exclusive time
+ * being its inclusive time less the inclusive time of its children. The
+ * scopes that didn't fit must be counted as dropped, without unbalancing
+ * the others. The Chrome trace must hold a complete event for every scope,
+ * and the collapsed stacks must add up to the time of the outer scopes.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The profile and its exports match the expected ones.
+ *
+ * 1 - The profile or its exports don't match the expected ones.
+ */
+
+#include <badline/scopedLogger.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <unistd.h>
+
+namespace {
+using EntriesT = std::map<std::string, sl::ScopeProfileEntry>;
+
+void spin(std::chrono::microseconds const d) {
+  auto const end = std::chrono::steady_clock::now() + d;
+  while (std::chrono::steady_clock::now() < end)
+    ;
+}
+
+void frame(sl::LoggerT *const logger) {
+  sl::FunctionScope const scope{logger, "frame"};
+  {
+    sl::FunctionScope const update{logger, "update"};
+    spin(std::chrono::microseconds{100});
+  }
+  sl::FunctionScope const render{logger, "render"};
+  for (int i = 0; i < 2; ++i) {
+    sl::FunctionScope const draw{logger, "draw"};
+    spin(std::chrono::microseconds{200});
+  }
+}
+
+void worker(sl::LoggerT *const logger) {
+  sl::FunctionScope const scope{logger, "worker"};
+  for (int i = 0; i < 100; ++i)
+    sl::FunctionScope const work{logger, "work"};
+}
+
+void overflow(sl::LoggerT *const logger) {
+  for (int i = 0; i < 20; ++i) {
+    sl::FunctionScope const outer{logger, "outer"};
+    sl::FunctionScope const inner{logger, "inner"};
+  }
+}
+
+// Every exclusive time has to be the inclusive time less the inclusive
+// time of the direct children.
+bool isConsistent(EntriesT const &entries) {
+  for (auto const &[path, e] : entries) {
+    std::uint64_t children{};
+    for (auto const &[other, c] : entries)
+      if (other.rfind(path + ";", 0) == 0 &&
+          other.find(';', path.size() + 1) == std::string::npos)
+        children += c.inclusiveNs;
+    if (e.inclusiveNs != e.exclusiveNs + children)
+      return false;
+  }
+  return true;
+}
+
+bool hasCalls(EntriesT const &entries,
+              std::map<std::string, std::size_t> const &calls) {
+  if (entries.size() != calls.size())
+    return false;
+  for (auto const &[path, count] : calls)
+    if (!entries.count(path) || entries.at(path).calls != count)
+      return false;
+  return true;
+}
+
+std::string readFile(std::string const &path) {
+  std::ifstream file{path};
+  std::stringstream s{};
+  s << file.rdbuf();
+  return s.str();
+}
+
+std::size_t countOccurrences(std::string const &s, std::string const &what) {
+  std::size_t count{};
+  for (auto pos = s.find(what); pos != std::string::npos;
+       pos = s.find(what, pos + what.size()))
+    ++count;
+  return count;
+}
+
+// The collapsed stacks have to add up to the time of the outer scopes.
+bool checkExports(sl::LoggerT *const logger, EntriesT const &entries,
+                  std::size_t const scopes) {
+  auto const base = (std::filesystem::temp_directory_path() /
+                     ("testScopeProfile-" + std::to_string(::getpid())))
+                        .string();
+  bool success =
+      sl::writeChromeTrace(logger, base + ".json") == sl::Result::Success &&
+      sl::writeCollapsedStacks(logger, base + ".folded") ==
+          sl::Result::Success;
+
+  auto const trace = readFile(base + ".json");
+  success = success && trace.rfind("{", 0) == 0 &&
+            trace.substr(trace.size() - 3) == "]}\n" &&
+            countOccurrences(trace, "\"ph\": \"X\"") == scopes;
+
+  std::uint64_t total{}, outer{};
+  std::ifstream folded{base + ".folded"};
+  for (std::string path{}, ns{}; folded >> path >> ns;)
+    total += std::stoull(ns);
+  for (auto const &[path, e] : entries)
+    if (countOccurrences(path, ";") == 1)
+      outer += e.inclusiveNs;
+  std::cout << "collapsed: " << total << ", outer: " << outer << std::endl;
+
+  std::filesystem::remove(base + ".json");
+  std::filesystem::remove(base + ".folded");
+  return success && total == outer;
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc != 2) {
+    std::cerr << "Wrong argument count; Usage: <tree|threads|overflow>\n";
+    return 1;
+  }
+
+  std::string const mode{argv[1]};
+  sl::LoggerT *logger{};
+  if (sl::createLogger(&logger, "test") != sl::Result::Success)
+    return 1;
+
+  bool success =
+      sl::resizeProfileBuffer(logger, 1) ==
+      sl::Result::ErrorProfileBufferSizeNotValid;
+  std::map<std::string, std::size_t> calls{};
+  std::size_t threads = 1, dropped = 0;
+  {
+    // The scope entered before the profiling mode is left out.
+    sl::FunctionScope const scope{logger, "main"};
+    success = success && sl::profileScopes(logger, true) == sl::Result::Success;
+
+    if (mode == "tree") {
+      for (int i = 0; i < 3; ++i)
+        frame(logger);
+      calls = {{"test;frame", 3},
+               {"test;frame;update", 3},
+               {"test;frame;render", 3},
+               {"test;frame;render;draw", 6}};
+    } else if (mode == "threads") {
+      std::vector<std::thread> workers{};
+      for (int i = 0; i < 4; ++i)
+        workers.emplace_back(worker, logger);
+      for (auto &w : workers)
+        w.join();
+      threads = 4;
+      calls = {{"test;worker", 4}, {"test;worker;work", 400}};
+    } else {
+      success = success &&
+                sl::resizeProfileBuffer(logger, 10) == sl::Result::Success;
+      overflow(logger);
+      calls = {{"test;outer", 3}, {"test;outer;inner", 2}};
+      dropped = 35;
+    }
+  }
+
+  sl::ScopeProfile profile{};
+  success = success &&
+            sl::getScopeProfile(logger, &profile) == sl::Result::Success;
+  EntriesT entries{};
+  std::size_t scopes{};
+  for (auto const &e : profile.entries) {
+    std::cout << e.path << " " << e.calls << " " << e.inclusiveNs << " "
+              << e.exclusiveNs << std::endl;
+    entries[e.path] = e;
+    scopes += e.calls;
+  }
+  std::cout << "threads: " << profile.threads
+            << ", dropped: " << profile.droppedScopes << std::endl;
+
+  success = success && profile.threads == threads &&
+            profile.droppedScopes == dropped && hasCalls(entries, calls) &&
+            isConsistent(entries) && checkExports(logger, entries, scopes);
+  if (mode == "tree")
+    success = success && entries["test;frame;render;draw"].inclusiveNs >=
+                             6 * 200000;
+  sl::destroyLogger(logger);
+  return success ? 0 : 1;
+}
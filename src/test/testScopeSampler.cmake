@@ -0,0 +1,5 @@
+add_executable(testScopeSampler testScopeSampler.cpp)
+target_link_libraries(testScopeSampler scopedLogger)
+
+add_test(NAME scopeSamplerTest0001 COMMAND testScopeSampler profile)
+add_test(NAME scopeSamplerTest0002 COMMAND testScopeSampler torn)
@@ -0,0 +1,170 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary tests the sampling of the scope stacks. The parameter is
+ * the case to run: 'profile' samples threads spending most of their time
+ * in one scope, and 'torn' a thread switching between scopes as fast as it
+ * can.
+ *
+ * The profile must find the busy threads mostly in their hot scope, and
+ * an idle thread outside of any scope, and its exports must add up to the
+ * samples. Every stack sampled must have been the stack of the thread at
+ * some point, even while the thread keeps changing it.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The profile and its exports match the expected ones.
+ *
+ * 1 - The profile or its exports don't match the expected ones.
+ */
+
+#include <badline/scopedLogger.hpp>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <unistd.h>
+
+namespace {
+std::atomic<bool> stop{};
+
+void spin(std::chrono::microseconds const d) {
+  auto const end = std::chrono::steady_clock::now() + d;
+  while (std::chrono::steady_clock::now() < end)
+    ;
+}
+
+void busy(sl::LoggerT *const logger) {
+  sl::FunctionScope const scope{logger, "worker"};
+  while (!stop.load()) {
+    {
+      sl::FunctionScope const hot{logger, "hot"};
+      spin(std::chrono::microseconds{900});
+    }
+    sl::FunctionScope const cold{logger, "cold"};
+    spin(std::chrono::microseconds{100});
+  }
+}
+
+void idle(sl::LoggerT *const logger) {
+  { sl::FunctionScope const scope{logger, "setup"}; }
+  while (!stop.load())
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+}
+
+void churn(sl::LoggerT *const logger) {
+  while (!stop.load()) {
+    {
+      sl::FunctionScope const a{logger, "a"};
+      sl::FunctionScope const b{logger, "b"};
+    }
+    sl::FunctionScope const c{logger, "c"};
+  }
+}
+
+bool checkExports(sl::LoggerT *const logger, sl::SampleProfile const &p) {
+  auto const path = (std::filesystem::temp_directory_path() /
+                     ("testScopeSampler-" + std::to_string(::getpid())))
+                        .string();
+  std::size_t total{};
+  bool success = sl::writeSampledStacks(logger, path) == sl::Result::Success;
+  std::ifstream folded{path};
+  for (std::string stack{}, samples{}; folded >> stack >> samples;)
+    total += std::stoul(samples);
+  std::filesystem::remove(path);
+
+  std::stringstream tree{};
+  auto *const original = std::cout.rdbuf(tree.rdbuf());
+  success = success && sl::printSampleProfile(logger) == sl::Result::Success;
+  std::cout.rdbuf(original);
+  std::cout << tree.str();
+
+  return success && total == p.samples &&
+         tree.str().rfind("test: " + std::to_string(p.samples) + " samples",
+                          0) == 0 &&
+         tree.str().find("\n  worker: ") != std::string::npos &&
+         tree.str().find("\n    hot: ") != std::string::npos;
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc != 2) {
+    std::cerr << "Wrong argument count; Usage: <profile|torn>\n";
+    return 1;
+  }
+
+  std::string const mode{argv[1]};
+  sl::LoggerT *logger{};
+  if (sl::createLogger(&logger, "test") != sl::Result::Success)
+    return 1;
+
+  bool success =
+      sl::setSampleRate(logger, 0) == sl::Result::ErrorSampleRateNotValid &&
+      sl::setSampleRate(logger, 2000) == sl::Result::Success &&
+      sl::sampleScopes(logger, true) == sl::Result::Success;
+
+  std::vector<std::thread> threads{};
+  if (mode == "profile") {
+    threads.emplace_back(busy, logger);
+    threads.emplace_back(busy, logger);
+    threads.emplace_back(idle, logger);
+  } else {
+    threads.emplace_back(churn, logger);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds{500});
+  success = success && sl::sampleScopes(logger, false) == sl::Result::Success;
+  stop.store(true);
+  for (auto &t : threads)
+    t.join();
+
+  sl::SampleProfile profile{};
+  success = success &&
+            sl::getSampleProfile(logger, &profile) == sl::Result::Success;
+  std::map<std::string, std::size_t> samples{};
+  for (auto const &e : profile.entries) {
+    std::cout << e.path << " " << e.samples << std::endl;
+    samples[e.path] = e.samples;
+  }
+  std::cout << "samples: " << profile.samples
+            << ", idle: " << profile.idleSamples
+            << ", missed: " << profile.missedSamples << std::endl;
+
+  success = success && profile.samples >= 10;
+  if (mode == "profile") {
+    success = success && profile.idleSamples &&
+              samples["test;worker;hot"] > samples["test;worker;cold"] &&
+              checkExports(logger, profile);
+  } else {
+    std::set<std::string> const valid{"test;a", "test;a;b", "test;c"};
+    for (auto const &[path, count] : samples)
+      success = success && valid.count(path);
+  }
+  sl::destroyLogger(logger);
+  return success ? 0 : 1;
+}
@@ -0,0 +1,9 @@
+add_executable(testSnapshot testSnapshot.cpp)
+target_link_libraries(testSnapshot argParser)
+
+add_test(NAME snapshotTest0001 COMMAND testSnapshot)
+add_test(NAME snapshotTest0002 COMMAND testSnapshot "-v" "--output" "out.txt" "input")
+add_test(NAME snapshotTest0003 COMMAND testSnapshot "--level=high" "-vv" "-l" "low" "abc" "def")
+add_test(NAME snapshotTest0004 COMMAND testSnapshot "--verbose" "--" "--output" "-o" "--" "-x")
+add_test(NAME snapshotTest0005 COMMAND testSnapshot "-v" "build" "--release" "-j" "4" "src")
+add_test(NAME snapshotTest0006 COMMAND testSnapshot "--level=high" "build")
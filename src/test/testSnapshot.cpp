@@ -0,0 +1,172 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary tests saving parse results with 'saveParseResult' and reading
+ * them back with 'attachParseResult'. The parameters are the command line
+ * to parse, with the flag 'verbose' (v), the options 'output' (o) and
+ * 'level' (l), and the subcommand 'build' registered. The subcommand has
+ * the flag 'release' and the option 'jobs' (j).
+ *
+ * The results are saved into shared memory, and a forked process attaches
+ * them to a handle without any arguments registered. Every accessor must
+ * then return the same results as the handle which parsed the input.
+ * The buffer must also be rejected once it is truncated.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The attached results match the parsed ones.
+ *
+ * 1 - The input was rejected, or the attached results don't match.
+ */
+
+#include <badline/argParser.hpp>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <iostream>
+
+namespace {
+bool sameResults(ap::ArgParserT const *const parsed,
+                 ap::ArgParserT const *const attached) {
+  for (std::string const name :
+       {"verbose", "output", "level", "release", "jobs", "missing"}) {
+    std::size_t count{}, expectedCount{};
+    bool const isFlag = name == "verbose" || name == "release";
+    auto const getCount = isFlag ? ap::getFlagCount : ap::getOptionCount;
+    if (getCount(parsed, name, &expectedCount) != ap::Result::Success ||
+        getCount(attached, name, &count) != ap::Result::Success ||
+        count != expectedCount)
+      return false;
+
+    for (std::size_t i = 0; i < count; ++i) {
+      std::size_t position{}, expectedPosition{};
+      auto const getPosition = isFlag ? ap::getFlagInstancePosition
+                                      : ap::getOptionInstancePosition;
+      getPosition(parsed, name, i, &expectedPosition);
+      getPosition(attached, name, i, &position);
+
+      std::string value{}, expectedValue{};
+      if (!isFlag) {
+        ap::getOptionInstanceValue(parsed, name, i, &expectedValue);
+        ap::getOptionInstanceValue(attached, name, i, &value);
+      }
+
+      std::cout << name << ": " << position << " " << value << std::endl;
+      if (position != expectedPosition || value != expectedValue)
+        return false;
+    }
+  }
+
+  std::size_t count{}, expectedCount{};
+  ap::getFreeValueCount(parsed, &expectedCount);
+  ap::getFreeValueCount(attached, &count);
+  if (count != expectedCount)
+    return false;
+
+  for (std::size_t i = 0; i < count; ++i) {
+    std::size_t position{}, expectedPosition{};
+    std::string value{}, expectedValue{};
+    ap::getFreeValueInstancePosition(parsed, i, &expectedPosition);
+    ap::getFreeValueInstancePosition(attached, i, &position);
+    ap::getFreeValueInstanceValue(parsed, i, &expectedValue);
+    ap::getFreeValueInstanceValue(attached, i, &value);
+
+    std::cout << "free value: " << position << " " << value << std::endl;
+    if (position != expectedPosition || value != expectedValue)
+      return false;
+  }
+
+  std::string name{}, expectedName{};
+  ap::ArgParserT *subcommand{}, *expectedSubcommand{};
+  if (ap::getSubcommand(parsed, &expectedName, &expectedSubcommand) !=
+          ap::Result::Success ||
+      ap::getSubcommand(attached, &name, &subcommand) !=
+          ap::Result::Success ||
+      name != expectedName || !subcommand != !expectedSubcommand)
+    return false;
+
+  if (!subcommand)
+    return true;
+  std::cout << "subcommand: " << name << std::endl;
+  return sameResults(expectedSubcommand, subcommand);
+}
+
+int checkAttached(ap::ArgParserT const *const parsed, void const *const data,
+                  std::size_t const size) {
+  ap::ArgParserT *attached{};
+  if (ap::createArgParser(&attached) != ap::Result::Success)
+    return 1;
+
+  bool const truncatedRejected =
+      ap::attachParseResult(attached, data, size - 1) ==
+      ap::Result::ErrorParseResultNotValid;
+  bool const success =
+      truncatedRejected &&
+      ap::attachParseResult(attached, data, size) == ap::Result::Success &&
+      sameResults(parsed, attached);
+
+  ap::destroyArgParser(attached);
+  return success ? 0 : 1;
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  ap::ArgParserT *handle{};
+  if (ap::createArgParser(&handle) != ap::Result::Success)
+    return 1;
+
+  auto const buildSpec = [](ap::ArgParserT *const build) {
+    if (auto r = ap::addFlag(build, "release"); r != ap::Result::Success)
+      return r;
+    return ap::addOption(build, "jobs", 'j');
+  };
+
+  if (ap::addFlag(handle, "verbose", 'v') != ap::Result::Success ||
+      ap::addOption(handle, "output", 'o') != ap::Result::Success ||
+      ap::addOption(handle, "level", 'l') != ap::Result::Success ||
+      ap::addSubcommand(handle, "build", buildSpec) != ap::Result::Success)
+    return 1;
+
+  std::size_t size{};
+  if (argc > 1 && ap::parse(handle, argv, 1, argc) != ap::Result::Success)
+    return 1;
+  if (ap::saveParseResult(handle, nullptr, 0, &size) != ap::Result::Success)
+    return 1;
+
+  void *const buffer = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (buffer == MAP_FAILED ||
+      ap::saveParseResult(handle, buffer, size, &size) != ap::Result::Success)
+    return 1;
+
+  pid_t const child = fork();
+  if (child == 0)
+    _exit(checkAttached(handle, buffer, size));
+
+  int status{};
+  bool const success = child > 0 && waitpid(child, &status, 0) == child &&
+                       WIFEXITED(status) && WEXITSTATUS(status) == 0;
+
+  munmap(buffer, size);
+  ap::destroyArgParser(handle);
+  return success ? 0 : 1;
+}
@@ -0,0 +1,31 @@
+add_executable(testSpecCache testSpecCache.cpp)
+target_link_libraries(testSpecCache argParser)
+
+add_test(NAME specCacheTest0001 COMMAND testSpecCache parse "-v" "--output" "out.txt" "--level=high")
+add_test(NAME specCacheTest0002 COMMAND testSpecCache parse "--verb" "--outp=a.txt" "-l" "low")
+add_test(NAME specCacheTest0003 COMMAND testSpecCache parse "--ver")
+add_test(NAME specCacheTest0004 COMMAND testSpecCache parse "--verbos" "--vrsion")
+add_test(NAME specCacheTest0005 COMMAND testSpecCache parse "--lvel=xy")
+add_test(NAME specCacheTest0006 COMMAND testSpecCache parse "-vo" "file" "free")
+add_test(NAME specCacheTest0007 COMMAND testSpecCache corrupt magic)
+add_test(NAME specCacheTest0008 COMMAND testSpecCache corrupt version)
+add_test(NAME specCacheTest0009 COMMAND testSpecCache corrupt totalSize)
+add_test(NAME specCacheTest0010 COMMAND testSpecCache corrupt maxLength)
+add_test(NAME specCacheTest0011 COMMAND testSpecCache corrupt nodeCount)
+add_test(NAME specCacheTest0012 COMMAND testSpecCache corrupt poolOffset)
+add_test(NAME specCacheTest0013 COMMAND testSpecCache corrupt cycle)
+add_test(NAME specCacheTest0014 COMMAND testSpecCache corrupt childCount)
+add_test(NAME specCacheTest0015 COMMAND testSpecCache corrupt sharedChild)
+add_test(NAME specCacheTest0016 COMMAND testSpecCache corrupt leafCount)
+add_test(NAME specCacheTest0017 COMMAND testSpecCache corrupt anyTerminal)
+add_test(NAME specCacheTest0018 COMMAND testSpecCache corrupt terminal)
+add_test(NAME specCacheTest0019 COMMAND testSpecCache corrupt label)
+add_test(NAME specCacheTest0020 COMMAND testSpecCache corrupt nameOffset)
+add_test(NAME specCacheTest0021 COMMAND testSpecCache corrupt nameLength)
+add_test(NAME specCacheTest0022 COMMAND testSpecCache corrupt argName)
+add_test(NAME specCacheTest0023 COMMAND testSpecCache corrupt duplicate)
+add_test(NAME specCacheTest0024 COMMAND testSpecCache corrupt truncated)
+add_test(NAME specCacheTest0025 COMMAND testSpecCache corrupt relabel)
+add_test(NAME specCacheTest0026 COMMAND testSpecCache corrupt swappedNames)
+add_test(NAME specCacheTest0027 COMMAND testSpecCache corrupt argCount)
+add_test(NAME specCacheTest0028 COMMAND testSpecCache corrupt crossDuplicate)
@@ -0,0 +1,248 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary tests saving a spec with 'saveSpec' and loading it with
+ * 'loadSpec'. The flags 'verbose' (v), 'version' and 'verify', and
+ * the options 'output' (o) and 'level' (l) are registered and saved.
+ *
+ * When the first parameter is 'parse', the remaining parameters are
+ * a command line, which is parsed, with long form abbreviations allowed,
+ * both by the handle the spec was registered with and by one the spec was
+ * loaded into. Both handles must accept or reject it alike, and report
+ * the same arguments and suggestions.
+ *
+ * When the first parameter is 'corrupt', the second one names a field
+ * of the saved spec, which is damaged before the spec is loaded. Loading
+ * must then fail, and leave the handle without any arguments.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The loaded spec behaves as expected.
+ *
+ * 1 - The results don't match the expectations.
+ */
+
+#include <argParser/internals.hpp>
+#include <filesystem>
+#include <iostream>
+#include <fstream>
+#include <cstring>
+
+namespace {
+// The layout of the header written by saveSpec.
+struct HeaderT {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byteOrder;
+  std::uint32_t nodeSize;
+  std::uint32_t trieMaxLength;
+  std::uint64_t totalSize;
+
+  std::uint64_t argOffset, argCount;
+  std::uint64_t nodeOffset, nodeCount;
+  std::uint64_t nameOffset, nameCount;
+  std::uint64_t poolOffset, poolSize;
+};
+
+using NodeT = ap::LongFormTrieT::NodeT;
+using NameT = ap::LongFormTrieT::NameT;
+
+int createSpec(ap::ArgParserT **const handle) {
+  if (auto r = ap::createArgParser(handle); r != ap::Result::Success)
+    return r;
+
+  ap::ArgParserT *const h = *handle;
+  for (auto r : {ap::addFlag(h, "verbose", 'v'), ap::addFlag(h, "version"),
+                 ap::addFlag(h, "verify"), ap::addOption(h, "output", 'o'),
+                 ap::addOption(h, "level", 'l'),
+                 ap::allowLongFormAbbreviations(h, true)})
+    if (r != ap::Result::Success)
+      return r;
+  return ap::Result::Success;
+}
+
+std::string describe(ap::ArgParserT *const handle, int const result) {
+  std::string output{}, suggestion{};
+  ap::Result::toString(result, &output);
+  ap::getLongFormSuggestion(handle, &suggestion);
+  output += " suggestion=" + suggestion;
+
+  for (std::string const name : {"verbose", "version", "verify"}) {
+    std::size_t count{};
+    ap::getFlagCount(handle, name, &count);
+    output += " " + name + "=" + std::to_string(count);
+  }
+  for (std::string const name : {"output", "level"}) {
+    std::size_t count{};
+    ap::getOptionCount(handle, name, &count);
+    output += " " + name + "=" + std::to_string(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      std::string value{};
+      ap::getOptionInstanceValue(handle, name, i, &value);
+      output += ":" + value;
+    }
+  }
+  return output;
+}
+
+bool roundTrip(ap::ArgParserT *const registered, std::string const &path,
+               char const *const *const input, std::size_t const size) {
+  ap::ArgParserT *loaded{};
+  if (ap::createArgParser(&loaded) != ap::Result::Success)
+    return false;
+
+  bool const success =
+      ap::loadSpec(loaded, path) == ap::Result::Success &&
+      ap::allowLongFormAbbreviations(loaded, true) == ap::Result::Success;
+  std::string const expected =
+      describe(registered, ap::parse(registered, input, 0, size));
+  std::string const result =
+      success ? describe(loaded, ap::parse(loaded, input, 0, size)) : "";
+
+  std::cout << "registered: " << expected << std::endl;
+  std::cout << "loaded: " << result << std::endl;
+  ap::destroyArgParser(loaded);
+  return success && result == expected;
+}
+
+template <typename T>
+T &at(std::vector<char> &blob, std::uint64_t const offset) {
+  return *reinterpret_cast<T *>(blob.data() + offset);
+}
+
+bool corrupt(std::vector<char> &blob, std::string const &field) {
+  auto &h = at<HeaderT>(blob, 0);
+  auto node = [&blob, &h](std::uint64_t const i) -> NodeT & {
+    return at<NodeT>(blob, h.nodeOffset + i * sizeof(NodeT));
+  };
+  auto name = [&blob, &h](std::uint64_t const i) -> NameT & {
+    return at<NameT>(blob, h.nameOffset + i * sizeof(NameT));
+  };
+
+  if (field == "magic")
+    h.magic[0] = 'X';
+  else if (field == "version")
+    ++h.version;
+  else if (field == "totalSize")
+    h.totalSize += 8;
+  else if (field == "maxLength")
+    h.trieMaxLength = 3;
+  else if (field == "nodeCount")
+    h.nodeCount = ~std::uint64_t{} / 2;
+  else if (field == "poolOffset")
+    h.poolOffset = h.totalSize + 8;
+  else if (field == "cycle")
+    node(node(0).firstChild).firstChild = 0;
+  else if (field == "childCount")
+    node(0).childCount = h.nodeCount;
+  else if (field == "sharedChild")
+    node(node(0).firstChild + 1).firstChild =
+        node(node(0).firstChild).firstChild;
+  else if (field == "leafCount")
+    ++node(node(0).firstChild).leafCount;
+  else if (field == "anyTerminal")
+    node(0).anyTerminal = h.nameCount;
+  else if (field == "terminal")
+    node(h.nodeCount - 1).terminal = h.nameCount;
+  else if (field == "label")
+    std::swap(node(1).label, node(2).label);
+  else if (field == "nameOffset")
+    name(0).offset = h.poolSize;
+  else if (field == "nameLength")
+    name(0).length = h.poolSize;
+  else if (field == "argName")
+    at<std::uint32_t>(blob, h.argOffset) = h.nameCount;
+  else if (field == "duplicate")
+    at<std::uint32_t>(blob, h.argOffset + 8) =
+        at<std::uint32_t>(blob, h.argOffset);
+  else if (field == "relabel")
+    node(node(node(0).firstChild).firstChild).label = 'x';
+  else if (field == "swappedNames")
+    std::swap(name(0), name(1));
+  else if (field == "argCount")
+    --h.argCount;
+  else if (field == "crossDuplicate")
+    at<std::uint32_t>(blob, h.argOffset + 8 * (h.argCount - 1)) =
+        at<std::uint32_t>(blob, h.argOffset);
+  else if (field == "truncated")
+    blob.resize(blob.size() - 1);
+  else
+    return false;
+  return true;
+}
+
+bool loadCorrupted(std::string const &path, std::string const &field) {
+  std::vector<char> blob(std::filesystem::file_size(path));
+  std::ifstream{path, std::ios::binary}.read(blob.data(), blob.size());
+  if (!corrupt(blob, field))
+    return false;
+  std::ofstream{path, std::ios::binary | std::ios::trunc}.write(blob.data(),
+                                                                blob.size());
+
+  ap::ArgParserT *loaded{};
+  if (ap::createArgParser(&loaded) != ap::Result::Success)
+    return false;
+
+  int const r = ap::loadSpec(loaded, path);
+  std::string result{};
+  ap::Result::toString(r, &result);
+  std::cout << "field: " << field << std::endl;
+  std::cout << "result: " << result << std::endl;
+
+  // A rejected spec leaves the handle as it was, so the arguments
+  // can still be registered one by one.
+  bool const success = r == ap::Result::ErrorSpecFormatNotValid &&
+                       ap::addFlag(loaded, "verbose") == ap::Result::Success &&
+                       ap::addOption(loaded, "level") == ap::Result::Success;
+  ap::destroyArgParser(loaded);
+  return success;
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc < 2) {
+    std::cerr << "Too few arguments; Usage: parse <input...> | corrupt "
+                 "<field>\n";
+    return 1;
+  }
+
+  std::string const mode = argv[1];
+  auto const path = (std::filesystem::temp_directory_path() /
+                     ("testSpecCache." + std::to_string(getpid())))
+                        .string();
+
+  ap::ArgParserT *handle{};
+  if (createSpec(&handle) != ap::Result::Success)
+    return 1;
+
+  bool success = ap::saveSpec(handle, path) == ap::Result::Success;
+  if (success && mode == "parse" && argc > 2)
+    success = roundTrip(handle, path, argv + 2, argc - 2);
+  else if (success && mode == "corrupt" && argc == 3)
+    success = loadCorrupted(path, argv[2]);
+  else
+    success = false;
+
+  ap::destroyArgParser(handle);
+  std::filesystem::remove(path);
+  return success ? 0 : 1;
+}
@@ -0,0 +1,11 @@
+add_executable(testSubcommand testSubcommand.cpp)
+target_link_libraries(testSubcommand argParser)
+
+add_test(NAME subcommandTest0001 COMMAND testSubcommand "-v build --release -j 4" "build release=1 jobs=1 partial=0")
+add_test(NAME subcommandTest0002 COMMAND testSubcommand "-v value" "none")
+add_test(NAME subcommandTest0003 COMMAND testSubcommand "build" "build release=0 jobs=0 partial=0")
+add_test(NAME subcommandTest0004 COMMAND testSubcommand "build --verbose" "error")
+add_test(NAME subcommandTest0005 COMMAND testSubcommand "build -j 2" "build release=0 jobs=1 partial=0" "-v" "none")
+add_test(NAME subcommandTest0006 COMMAND testSubcommand "build --release" "build release=1 jobs=0 partial=0" "build --release" "build release=2 jobs=0 partial=0")
+add_test(NAME subcommandTest0007 COMMAND testSubcommand "broken" "error" "-v" "none" "broken --partial" "broken release=0 jobs=0 partial=1")
+add_test(NAME subcommandTest0008 COMMAND testSubcommand "-v build build" "build release=0 jobs=0 partial=0")
@@ -0,0 +1,116 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary tests lazily specified subcommands. The parameters are
+ * pairs of a command line and the expected result, which are parsed one
+ * after another by the same handle.
+ *
+ * The flag 'verbose' (v) and the subcommands 'build' and 'broken' are
+ * registered. The subcommand 'build' has the flag 'release' and the option
+ * 'jobs' (j). The spec of 'broken' registers the flag 'partial', but fails
+ * the first time it is invoked.
+ *
+ * The result is 'error' when the command line is expected to be rejected,
+ * 'none' when no subcommand is expected to be met, or otherwise the name
+ * of the subcommand followed by the counts of its arguments, e.g.
+ * 'build release=1 jobs=2 partial=0'. The spec of every subcommand must
+ * be invoked once it has succeeded.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - All the results match the expectations.
+ *
+ * 1 - One of the results doesn't match the expectations.
+ */
+
+#include <badline/argParser.hpp>
+#include <iostream>
+
+namespace {
+std::size_t buildSpecCalls{};
+std::size_t brokenSpecCalls{};
+
+int buildSpec(ap::ArgParserT *const handle) {
+  ++buildSpecCalls;
+  if (auto r = ap::addFlag(handle, "release"); r != ap::Result::Success)
+    return r;
+  return ap::addOption(handle, "jobs", 'j');
+}
+
+int brokenSpec(ap::ArgParserT *const handle) {
+  if (auto r = ap::addFlag(handle, "partial"); r != ap::Result::Success)
+    return r;
+  return brokenSpecCalls++ ? ap::Result::Success
+                           : ap::Result::ErrorArgLongFormNotValid;
+}
+
+std::string describe(ap::ArgParserT const *const handle) {
+  std::string name{};
+  ap::ArgParserT *subcommand{};
+  if (ap::getSubcommand(handle, &name, &subcommand) != ap::Result::Success)
+    return "error";
+  if (name.empty())
+    return subcommand ? "error" : "none";
+  if (!subcommand)
+    return "error";
+
+  std::size_t release{}, partial{}, jobs{};
+  ap::getFlagCount(subcommand, "release", &release);
+  ap::getFlagCount(subcommand, "partial", &partial);
+  ap::getOptionCount(subcommand, "jobs", &jobs);
+  return name + " release=" + std::to_string(release) +
+         " jobs=" + std::to_string(jobs) +
+         " partial=" + std::to_string(partial);
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc < 3 || argc % 2 == 0) {
+    std::cerr << "Wrong argument count; Usage: <input> <expected> ...\n";
+    return 1;
+  }
+
+  ap::ArgParserT *handle{};
+  if (ap::createArgParser(&handle) != ap::Result::Success)
+    return 1;
+
+  bool success = ap::addFlag(handle, "verbose", 'v') == ap::Result::Success &&
+                 ap::addSubcommand(handle, "build", buildSpec) ==
+                     ap::Result::Success &&
+                 ap::addSubcommand(handle, "broken", brokenSpec) ==
+                     ap::Result::Success;
+
+  for (int i = 1; success && i < argc; i += 2) {
+    int const r = ap::parseCommandString(handle, argv[i]);
+    std::string const result = r == ap::Result::Success ? describe(handle)
+                                                        : "error";
+    std::cout << "input: " << argv[i] << std::endl;
+    std::cout << "result: " << result << std::endl;
+    success = result == argv[i + 1];
+  }
+
+  std::cout << "build spec calls: " << buildSpecCalls << std::endl;
+  std::cout << "broken spec calls: " << brokenSpecCalls << std::endl;
+
+  ap::destroyArgParser(handle);
+  return success && buildSpecCalls <= 1 && brokenSpecCalls <= 2 ? 0 : 1;
+}
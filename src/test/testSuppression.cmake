@@ -0,0 +1,6 @@
+add_executable(testSuppression testSuppression.cpp)
+target_link_libraries(testSuppression scopedLogger)
+
+add_test(NAME suppressionTest0001 COMMAND testSuppression fold)
+add_test(NAME suppressionTest0002 COMMAND testSuppression rate)
+add_test(NAME suppressionTest0003 COMMAND testSuppression columns)
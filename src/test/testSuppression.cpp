@@ -0,0 +1,182 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary tests the suppression of entries at their call sites. The
+ * parameter is the case to run: 'fold' folds repeated entries, through
+ * the text functions and the macros, 'rate' limits the rate of the
+ * entries of a call site, and 'columns' limits call sites that share a
+ * line.
+ *
+ * A repeated entry must be written once, and summed up before the next
+ * different entry of its call site. A call site over its rate limit must
+ * write its burst, drop the rest until its bucket refills, and then write
+ * how many entries it dropped, without affecting the other call sites.
+ * The counts of folded and dropped entries must be reported.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The entries and the counts match the expected ones.
+ *
+ * 1 - The entries or the counts don't match the expected ones.
+ */
+
+#include <badline/scopedLogger.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <unistd.h>
+
+namespace {
+std::vector<std::string> readLines(std::string const &path) {
+  std::vector<std::string> lines{};
+  std::ifstream file{path};
+  for (std::string line{}; std::getline(file, line);)
+    lines.push_back(line);
+  return lines;
+}
+
+// Every call in a lambda comes from one call site.
+bool fold(sl::LoggerT *const logger, std::vector<std::string> *const expected,
+          sl::SuppressionStats *const stats) {
+  auto const warn = [logger](std::string const &m) { sl::wrn(logger, m); };
+  auto const error = [logger](int const v) { SL_ERR(logger, "value {}", v); };
+  bool success = sl::foldDuplicates(logger, true) == sl::Result::Success;
+  for (int i = 0; i < 5; ++i)
+    warn("same");
+  warn("other");
+  sl::inf(logger, "other");
+  for (int i = 0; i < 3; ++i)
+    error(1);
+  error(2);
+  for (int i = 0; i < 2; ++i)
+    warn("same");
+  warn("last");
+
+  *expected = {"[Warning] test: same",
+               "[Warning] test: last message repeated 4 times",
+               "[Warning] test: other",
+               "[Info] test: other",
+               "[Error] test: value 1",
+               "[Error] test: last message repeated 2 times",
+               "[Error] test: value 2",
+               "[Warning] test: same",
+               "[Warning] test: last message repeated 1 times",
+               "[Warning] test: last"};
+  *stats = {0, 7};
+  return success;
+}
+
+bool rate(sl::LoggerT *const logger, std::vector<std::string> *const expected,
+          sl::SuppressionStats *const stats) {
+  auto const warn = [logger](int const i) {
+    sl::wrn(logger, "burst " + std::to_string(i));
+  };
+  bool success =
+      sl::setRateLimit(logger, 10, 0) == sl::Result::ErrorRateLimitNotValid &&
+      sl::setRateLimit(logger, 10, 5) == sl::Result::Success;
+  for (int i = 0; i < 100; ++i)
+    warn(i);
+  for (int i = 0; i < 3; ++i)
+    sl::inf(logger, "other " + std::to_string(i));
+  std::this_thread::sleep_for(std::chrono::milliseconds{250});
+  warn(100);
+  success = success && sl::setRateLimit(logger, 0, 0) == sl::Result::Success;
+  for (int i = 0; i < 10; ++i)
+    warn(101);
+
+  *expected = {};
+  for (int i = 0; i < 5; ++i)
+    expected->push_back("[Warning] test: burst " + std::to_string(i));
+  for (int i = 0; i < 3; ++i)
+    expected->push_back("[Info] test: other " + std::to_string(i));
+  expected->push_back(
+      "[Warning] test: 95 messages dropped by the rate limit");
+  expected->push_back("[Warning] test: burst 100");
+  for (int i = 0; i < 10; ++i)
+    expected->push_back("[Warning] test: burst 101");
+  *stats = {95, 0};
+  return success;
+}
+
+// The call sites on one line only differ by their column.
+bool columns(sl::LoggerT *const logger,
+             std::vector<std::string> *const expected,
+             sl::SuppressionStats *const stats) {
+  bool const success = sl::setRateLimit(logger, 1, 1) == sl::Result::Success;
+  for (int i = 0; i < 3; ++i) {
+    std::string const n = std::to_string(i);
+    // clang-format off
+    sl::wrn(logger, "a " + n); sl::wrn(logger, "b " + n); sl::inf(logger, "c " + n);
+    // clang-format on
+  }
+
+  *expected = {"[Warning] test: a 0", "[Warning] test: b 0",
+               "[Info] test: c 0"};
+  *stats = {6, 0};
+  return success;
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc != 2) {
+    std::cerr << "Wrong argument count; Usage: <fold|rate|columns>\n";
+    return 1;
+  }
+
+  std::string const mode{argv[1]};
+  auto const path = (std::filesystem::temp_directory_path() /
+                     ("testSuppression-" + std::to_string(::getpid()) + ".log"))
+                        .string();
+  sl::LoggerT *logger{};
+  if (sl::createLogger(&logger, "test") != sl::Result::Success)
+    return 1;
+  bool success = sl::outputToConsole(logger, false) == sl::Result::Success &&
+                 sl::outputToFile(logger, true) == sl::Result::Success &&
+                 sl::prefixTime(logger, false) == sl::Result::Success &&
+                 sl::setLogFile(logger, path) == sl::Result::Success;
+
+  std::vector<std::string> expected{};
+  sl::SuppressionStats expectedStats{}, stats{};
+  auto const run = mode == "fold"   ? fold
+                   : mode == "rate" ? rate
+                                    : columns;
+  success = success && run(logger, &expected, &expectedStats);
+  success = success && sl::flushLogFile(logger) == sl::Result::Success &&
+            sl::getSuppressionStats(logger, &stats) == sl::Result::Success;
+  sl::destroyLogger(logger);
+
+  auto const entries = readLines(path);
+  for (auto const &entry : entries)
+    std::cout << entry << "\n";
+  std::cout << "rateLimited: " << stats.rateLimited
+            << ", folded: " << stats.folded << std::endl;
+  std::filesystem::remove(path);
+  return success && entries == expected &&
+                 stats.rateLimited == expectedStats.rateLimited &&
+                 stats.folded == expectedStats.folded
+             ? 0
+             : 1;
+}
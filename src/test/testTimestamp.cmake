@@ -0,0 +1,10 @@
+add_executable(testTimestamp testTimestamp.cpp)
+target_link_libraries(testTimestamp scopedLogger)
+
+add_test(NAME timestampTest0001 COMMAND testTimestamp "%Y/%m/%d" "%H:%M:%S" 123456789 "2023/11/14 22:13:20")
+add_test(NAME timestampTest0002 COMMAND testTimestamp "%Y-%m-%d" "%H:%M:%S.%3N" 123456789 "2023-11-14 22:13:20.123")
+add_test(NAME timestampTest0003 COMMAND testTimestamp "%F" "%T.%N" 123456789 "2023-11-14 22:13:20.123456789")
+add_test(NAME timestampTest0004 COMMAND testTimestamp "%s" "%6N %%N %%" 1000 "1700000000 000001 %N %")
+add_test(NAME timestampTest0005 COMMAND testTimestamp "" "%9N%1N" 999999999 " 9999999999")
+add_test(NAME timestampTest0006 COMMAND testTimestamp "%d" "%S.%3N" 0 "14 20.000")
+add_test(NAME timestampTest0007 COMMAND testTimestamp "%Y/%m/%d" "%H:%M:%S.%2N" 1999999999 "2023/11/14 22:13:21.99")
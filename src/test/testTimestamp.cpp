@@ -0,0 +1,71 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary tests the cached timestamp formatting. The parameters are
+ * the date and time formats, the nanoseconds past 2023/11/14 22:13:20
+ * UTC to format, and the expected timestamp.
+ *
+ * The cache is first filled with another second, and with other formats,
+ * so that the timestamp is checked both when the cache is refreshed, and
+ * when the cached prefix is reused.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The timestamps match the expected one.
+ *
+ * 1 - The timestamps don't match the expected one.
+ */
+
+#include <scopedLogger/internals.hpp>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+
+int main(int const argc, char const *const *const argv) {
+  if (argc != 5) {
+    std::cerr << "Wrong argument count; Usage: <dateFormat> <timeFormat> "
+                 "<nanoseconds> <expected>\n";
+    return 1;
+  }
+
+  ::setenv("TZ", "UTC", 1);
+  ::tzset();
+
+  std::string const dateF{argv[1]}, timeF{argv[2]}, expected{argv[4]};
+  auto const time = std::chrono::system_clock::time_point{
+      std::chrono::seconds{1700000000} +
+      std::chrono::nanoseconds{std::stoll(argv[3])}};
+
+  std::string timestamp{};
+  sl::getTimestamp(time, "%Y", "%N", &timestamp);
+  sl::getTimestamp(time + std::chrono::seconds{1}, dateF, timeF, &timestamp);
+  std::cout << "next second: " << timestamp << std::endl;
+
+  sl::getTimestamp(time, dateF, timeF, &timestamp);
+  std::cout << "refreshed: " << timestamp << std::endl;
+  if (timestamp != expected)
+    return 1;
+
+  timestamp = sl::getTimestamp(time, dateF, timeF);
+  std::cout << "cached: " << timestamp << std::endl;
+  return timestamp == expected ? 0 : 1;
+}
@@ -0,0 +1,9 @@
+add_executable(testTokenCache testTokenCache.cpp)
+target_link_libraries(testTokenCache argParser)
+
+add_test(NAME tokenCacheTest0001 COMMAND testTokenCache 65536 2 2 "--level=high" "--dry-run" "--level=high" "--dry-run")
+add_test(NAME tokenCacheTest0002 COMMAND testTokenCache 65536 1 3 "--level=high" "--level=low" "-v" "--out-file=a.txt" "--level=low")
+add_test(NAME tokenCacheTest0003 COMMAND testTokenCache 300 0 4 "--level=high" "--dry-run" "--level=high" "--dry-run")
+add_test(NAME tokenCacheTest0004 COMMAND testTokenCache 300 2 2 "--level=high" "--level=high" "--dry-run" "--dry-run")
+add_test(NAME tokenCacheTest0005 COMMAND testTokenCache 0 0 0 "--level=high" "--level=high" "value" "-v")
+add_test(NAME tokenCacheTest0006 COMMAND testTokenCache 65536 1 1 "-l=xy" "--verbose" "free" "-l=xy")
@@ -0,0 +1,132 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary tests the token cache enabled by 'setTokenCacheSize'.
+ * The first parameter is the size of the cache in bytes, the second
+ * and the third ones are the expected hit and miss counts, and the
+ * remaining parameters are the command line to parse, with the flags
+ * 'verbose' (v) and 'dry-run', and the options 'level' (l) and
+ * 'out-file' registered.
+ *
+ * The same command line is also parsed by a handle without the cache,
+ * and both handles must report the same flags, options and free values.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The counters and the results match the expectations.
+ *
+ * 1 - The input was rejected, or the counters or the results
+ *     don't match.
+ */
+
+#include <badline/argParser.hpp>
+#include <iostream>
+#include <sstream>
+
+namespace {
+std::string describe(ap::ArgParserT const *const handle) {
+  std::ostringstream stream{};
+  for (std::string const name : {"verbose", "dry-run"}) {
+    std::size_t count{};
+    ap::getFlagCount(handle, name, &count);
+    for (std::size_t i = 0; i < count; ++i) {
+      std::size_t position{};
+      ap::getFlagInstancePosition(handle, name, i, &position);
+      stream << name << ":" << position << " ";
+    }
+  }
+
+  for (std::string const name : {"level", "out-file"}) {
+    std::size_t count{};
+    ap::getOptionCount(handle, name, &count);
+    for (std::size_t i = 0; i < count; ++i) {
+      std::size_t position{};
+      std::string value{};
+      ap::getOptionInstancePosition(handle, name, i, &position);
+      ap::getOptionInstanceValue(handle, name, i, &value);
+      stream << name << ":" << position << "=" << value << " ";
+    }
+  }
+
+  std::size_t count{};
+  ap::getFreeValueCount(handle, &count);
+  for (std::size_t i = 0; i < count; ++i) {
+    std::string value{};
+    ap::getFreeValueInstanceValue(handle, i, &value);
+    stream << "free:" << value << " ";
+  }
+  return stream.str();
+}
+
+bool parse(ap::ArgParserT *const handle, std::size_t const cacheSize,
+           char const *const *const input, std::size_t const size) {
+  return ap::addFlag(handle, "verbose", 'v') == ap::Result::Success &&
+         ap::addFlag(handle, "dry-run") == ap::Result::Success &&
+         ap::addOption(handle, "level", 'l') == ap::Result::Success &&
+         ap::addOption(handle, "out-file") == ap::Result::Success &&
+         ap::setTokenCacheSize(handle, cacheSize) == ap::Result::Success &&
+         ap::parse(handle, input, 0, size) == ap::Result::Success;
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc < 5) {
+    std::cerr << "Too few arguments; Usage: <cacheSize> <hits> <misses> "
+                 "<input...>\n";
+    return 1;
+  }
+
+  std::size_t const cacheSize = std::stoul(argv[1]);
+  std::size_t const expectedHits = std::stoul(argv[2]);
+  std::size_t const expectedMisses = std::stoul(argv[3]);
+  std::size_t const size = argc - 4;
+
+  ap::ArgParserT *cached{}, *plain{};
+  if (ap::createArgParser(&cached) != ap::Result::Success)
+    return 1;
+  if (ap::createArgParser(&plain) != ap::Result::Success) {
+    ap::destroyArgParser(cached);
+    return 1;
+  }
+
+  bool success = parse(cached, cacheSize, argv + 4, size) &&
+                 parse(plain, 0, argv + 4, size);
+
+  std::size_t hits{}, misses{}, plainHits{}, plainMisses{};
+  ap::getTokenCacheHitCount(cached, &hits);
+  ap::getTokenCacheMissCount(cached, &misses);
+  ap::getTokenCacheHitCount(plain, &plainHits);
+  ap::getTokenCacheMissCount(plain, &plainMisses);
+
+  std::string const result = describe(cached);
+  std::cout << "hits: " << hits << std::endl;
+  std::cout << "misses: " << misses << std::endl;
+  std::cout << "cached: " << result << std::endl;
+  std::cout << "plain: " << describe(plain) << std::endl;
+
+  success = success && hits == expectedHits && misses == expectedMisses &&
+            !plainHits && !plainMisses && result == describe(plain);
+
+  ap::destroyArgParser(cached);
+  ap::destroyArgParser(plain);
+  return success ? 0 : 1;
+}
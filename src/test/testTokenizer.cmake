@@ -0,0 +1,15 @@
+add_executable(testTokenizer testTokenizer.cpp)
+target_link_libraries(testTokenizer argParser)
+
+add_test(NAME tokenizeTest0001 COMMAND testTokenizer "  -a   --bb\tc\n" "-a" "--bb" "c")
+add_test(NAME tokenizeTest0002 COMMAND testTokenizer "--name='a b' x" "--name=a b" "x")
+add_test(NAME tokenizeTest0003 COMMAND testTokenizer "\"a\\\"b\\c\" d" "a\"b\\c" "d")
+add_test(NAME tokenizeTest0004 COMMAND testTokenizer "a\\ b \\'c" "a b" "'c")
+add_test(NAME tokenizeTest0005 COMMAND testTokenizer "'' \"\" x" "" "" "x")
+add_test(NAME tokenizeTest0006 COMMAND testTokenizer "ab'c'\"d\"e" "abcde")
+add_test(NAME tokenizeTest0007 COMMAND testTokenizer "--a-very-long-option-name-0123=value-0123456789 end" "--a-very-long-option-name-0123=value-0123456789" "end")
+add_test(NAME tokenizeTest0008 COMMAND testTokenizer "")
+add_test(NAME tokenizeTest0009 COMMAND testTokenizer "'unterminated")
+add_test(NAME tokenizeTest0010 COMMAND testTokenizer "trailing\\")
+
+set_tests_properties(tokenizeTest0009 tokenizeTest0010 PROPERTIES WILL_FAIL TRUE)
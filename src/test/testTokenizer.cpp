@@ -0,0 +1,67 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary tests the 'tokenize' method. The first parameter is
+ * a command line, and the remaining parameters are the tokens that
+ * the command line is expected to be split into.
+ *
+ * That is to say, if your input is 'a "b c"', then the expected tokens
+ * would be 'a' and 'b c'.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The command line was split into the expected tokens.
+ *
+ * 1 - The command line was rejected, or the tokens don't match
+ *     the expectations.
+ */
+
+#include <argParser/internals.hpp>
+#include <iostream>
+
+int main(int const argc, char const *const *const argv) {
+  if (argc < 2) {
+    std::cerr << "Too few arguments; Usage: <input> [tokens...]\n";
+    return 1;
+  }
+
+  std::string const input = argv[1];
+  ap::CommandTokensT tokens{};
+
+  std::cout << "input: " << input << std::endl;
+  if (auto r = ap::tokenize(input, &tokens); r != ap::Result::Success) {
+    std::string result{};
+    ap::Result::toString(r, &result);
+    std::cout << "result: " << result << std::endl;
+    return 1;
+  }
+
+  for (auto const token : tokens.argv)
+    std::cout << "token: " << token << std::endl;
+
+  if (tokens.argv.size() != std::size_t(argc - 2))
+    return 1;
+  for (std::size_t i = 0; i < tokens.argv.size(); ++i)
+    if (std::string{tokens.argv[i]} != argv[i + 2])
+      return 1;
+  return 0;
+}
@@ -0,0 +1,10 @@
+add_executable(testTrace testTrace.cpp)
+target_link_libraries(testTrace scopedLogger)
+
+add_test(NAME traceTest0001 COMMAND testTrace 1000 5000 32)
+add_test(NAME traceTest0002 COMMAND testTrace 10 3 32)
+add_test(NAME traceTest0003 COMMAND testTrace 100 1000 400)
+add_test(NAME traceTest0004 COMMAND testTrace 2 10 1000)
+add_test(NAME traceTest0005 COMMAND testTrace 1 10 16)
+add_test(NAME traceTest0006 COMMAND testTrace 1 10 1000)
+add_test(NAME traceTest0007 COMMAND testTrace 4 10 100000)
@@ -0,0 +1,139 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary tests the trace kept by the Buffer output mode. The
+ * parameters are the capacity of the trace in entries, the number of
+ * entries to log, and the length of their messages.
+ *
+ * Once the trace wrapped around, logging into it must not allocate. The
+ * trace printed afterwards must hold the most recent entries, in order,
+ * indented by their depth, with the oldest ones dropped once either the
+ * entry capacity or the string arena is exhausted. The arena holds at
+ * least minTraceArenaSize bytes, whatever the capacity, and grows to take
+ * a longer message whole.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The trace holds the expected entries, and logging didn't allocate.
+ *
+ * 1 - The trace doesn't hold the expected entries, or logging allocated.
+ */
+
+#include <badline/scopedLogger.hpp>
+#include <scopedLogger/internals.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+std::size_t allocations{};
+
+std::string makeMessage(std::size_t const i, std::size_t const length) {
+  std::string message = "message " + std::to_string(i) + " ";
+  message.resize(std::max(length, message.size()), 'x');
+  return message;
+}
+} // namespace
+
+void *operator new(std::size_t const size) {
+  ++allocations;
+  if (void *const p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc{};
+}
+
+void operator delete(void *const p) noexcept { std::free(p); }
+void operator delete(void *const p, std::size_t) noexcept { std::free(p); }
+
+int main(int const argc, char const *const *const argv) {
+  if (argc != 4) {
+    std::cerr << "Wrong argument count; Usage: <capacity> <count> "
+                 "<messageLength>\n";
+    return 1;
+  }
+
+  std::size_t const capacity = std::stoul(argv[1]);
+  std::size_t const count = std::stoul(argv[2]);
+  std::size_t const length = std::stoul(argv[3]);
+
+  std::vector<std::string> messages{};
+  for (std::size_t i = 0; i < 2 * capacity + count; ++i)
+    messages.push_back(makeMessage(i, length));
+
+  sl::LoggerT *logger{};
+  if (sl::createLogger(&logger, "test") != sl::Result::Success)
+    return 1;
+  bool success = sl::outputToConsole(logger, false) == sl::Result::Success &&
+                 sl::outputToBuffer(logger, true) == sl::Result::Success &&
+                 sl::resizeLogBuffer(logger, capacity) == sl::Result::Success;
+
+  std::size_t allocated{};
+  {
+    sl::FunctionScope const outer{logger, "outer"};
+    sl::FunctionScope const inner{logger, "inner"};
+    std::size_t i = 0;
+    for (; success && i < 2 * capacity; ++i)
+      success = sl::inf(logger, messages[i]) == sl::Result::Success;
+
+    std::size_t const before = allocations;
+    for (; success && i < messages.size(); ++i)
+      success = sl::inf(logger, messages[i]) == sl::Result::Success;
+    allocated = allocations - before;
+  }
+  std::cout << "allocations: " << allocated << std::endl;
+
+  std::stringstream trace{};
+  auto *const original = std::cout.rdbuf(trace.rdbuf());
+  sl::printTrace(logger);
+  std::cout.rdbuf(original);
+
+  // Every line holds the index of its message, and has to follow the
+  // previous one, with the last line holding the last message.
+  std::size_t const recordSize = 5 + length;
+  std::size_t arena =
+      std::max(capacity * sl::traceBytesPerEntry, sl::minTraceArenaSize);
+  if (recordSize > arena)
+    arena = std::max(recordSize, 2 * arena);
+  std::size_t lines{}, last{};
+  for (std::string line{}; success && std::getline(trace, line); ++lines) {
+    auto const pos = line.find("] inner: message ");
+    if (line.rfind("    ", 0) != 0 || line[4] == ' ' ||
+        pos == std::string::npos) {
+      success = false;
+      break;
+    }
+    std::size_t const index = std::stoul(line.substr(pos + 17));
+    std::string const message = line.substr(pos + 9);
+    success = (!lines || index == last + 1) && message == messages[index];
+    last = index;
+  }
+  std::cout << "lines: " << lines << std::endl;
+
+  success = success && !allocated && last == messages.size() - 1 &&
+            lines <= capacity && lines * recordSize <= arena &&
+            (lines == capacity || (lines + 2) * recordSize > arena);
+  sl::destroyLogger(logger);
+  return success ? 0 : 1;
+}
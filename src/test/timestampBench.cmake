@@ -0,0 +1,2 @@
+add_executable(timestampBench timestampBench.cpp)
+target_link_libraries(timestampBench scopedLogger)
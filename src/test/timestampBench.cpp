@@ -0,0 +1,125 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+/* DESCRIPTION:
+ *
+ * This binary measures the cached timestamp formatting against formatting
+ * every timestamp with localtime and put_time, as the logger used to.
+ * It takes one optional parameter, which is the number of timestamps
+ * formatted by every thread of a case (1000000 by default).
+ *
+ * Every case formats the current time with the default formats, from
+ * a given number of threads at once, so that the contention on the time
+ * zone lock of the C library shows. The cached formatting is measured
+ * with sub-second digits too.
+ *
+ * The results are printed to the standard output as a single JSON
+ * document, with the speedup of the cached formatting for every case.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - All the cases ran.
+ *
+ * 1 - Invalid usage.
+ */
+
+#include <scopedLogger/internals.hpp>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <chrono>
+
+namespace {
+using clock_t = std::chrono::steady_clock;
+using FormatT = void (*)(std::string const &, std::string const &,
+                         std::string *const);
+
+void formatUncached(std::string const &dateF, std::string const &timeF,
+                    std::string *const out) {
+  std::time_t const t = std::chrono::system_clock::to_time_t(
+      std::chrono::system_clock::now());
+  std::tm time = *std::localtime(&t);
+  std::stringstream buffer{};
+  buffer << std::put_time(&time, dateF.c_str()) << " ";
+  buffer << std::put_time(&time, timeF.c_str());
+  *out = buffer.str();
+}
+
+void formatCached(std::string const &dateF, std::string const &timeF,
+                  std::string *const out) {
+  sl::getTimestamp(std::chrono::system_clock::now(), dateF, timeF, out);
+}
+
+// Returns the nanoseconds per timestamp, over all the threads.
+double measure(FormatT const format, std::string const &timeF,
+               std::size_t const threads, std::size_t const count) {
+  std::string const dateF{"%Y/%m/%d"};
+  std::vector<std::thread> workers{};
+  std::vector<std::size_t> lengths(threads);
+
+  auto const start = clock_t::now();
+  for (std::size_t t = 0; t < threads; ++t)
+    workers.emplace_back([&, t] {
+      std::string timestamp{};
+      for (std::size_t i = 0; i < count; ++i) {
+        format(dateF, timeF, &timestamp);
+        lengths[t] += timestamp.size();
+      }
+    });
+  for (auto &worker : workers)
+    worker.join();
+  auto const d = clock_t::now() - start;
+  return std::chrono::duration<double, std::nano>(d).count() /
+         (threads * count);
+}
+} // namespace
+
+int main(int const argc, char const *const *const argv) {
+  if (argc > 2) {
+    std::cerr << "Too many arguments; Usage: [timestampsPerThread]\n";
+    return 1;
+  }
+
+  std::size_t const count = argc == 2 ? std::stoul(argv[1]) : 1000000;
+  std::vector<std::size_t> const threadCounts{1, 4};
+
+  std::cout << "{\n  \"benchmark\": \"timestamp\",\n  \"results\": [\n";
+  for (std::size_t i = 0; i < threadCounts.size(); ++i) {
+    std::size_t const threads = threadCounts[i];
+    double const uncachedNs =
+        measure(formatUncached, "%H:%M:%S", threads, count);
+    double const cachedNs = measure(formatCached, "%H:%M:%S", threads, count);
+    double const fractionNs =
+        measure(formatCached, "%H:%M:%S.%6N", threads, count);
+
+    std::cout << "    {\"threads\": " << threads << ", ";
+    std::cout << "\"uncachedNsPerTimestamp\": " << uncachedNs << ", ";
+    std::cout << "\"cachedNsPerTimestamp\": " << cachedNs << ", ";
+    std::cout << "\"cachedMicrosecondsNsPerTimestamp\": " << fractionNs
+              << ", ";
+    std::cout << "\"speedup\": " << uncachedNs / cachedNs << "}"
+              << (i + 1 == threadCounts.size() ? "\n" : ",\n");
+  }
+  std::cout << "  ]\n}" << std::endl;
+  return 0;
+}